@@ -14,7 +14,7 @@ AnimatedSprite::AnimatedSprite(SDL_Texture *const spritesheet,
                                const int frameWidth, const int frameCount,
                                const unsigned int frameDelay)
     : Sprite(spritesheet, framesRegion, drawRegion), _frameDelay(frameDelay),
-      _frameTick(0), _frameCount(frameCount), _currentFrame(0), _isPaused(true),
+      _startTick(0), _frameCount(frameCount), _currentFrame(0), _isPaused(true),
       _framesRegion(framesRegion) {
   SetSpriteRegionSize(frameHeight, frameWidth);
 }
@@ -59,10 +59,33 @@ void AnimatedSprite::SetFramesRegionSize(const int height, const int width) {
   SetFrame(0);
 }
 
-void AnimatedSprite::Update(unsigned int dt) {
-  _frameTick += (_isPaused ? 0 : dt);
-  if (_frameTick > _frameDelay) {
-    _frameTick = _frameTick % _frameDelay;
-    SetFrame(_currentFrame + 1);
-  }
+void AnimatedSprite::SetStartTick(const unsigned int value) {
+  _startTick = value;
+}
+
+unsigned int AnimatedSprite::GetStartTick() const { return _startTick; }
+
+Uint32 AnimatedSprite::GetFrameKey(const unsigned int tick) const {
+  int frame = _isPaused ? _currentFrame : GetFrameAt(tick);
+  return (static_cast<Uint32>(_framesRegion.x) & 0x3FF) |
+         (static_cast<Uint32>(_framesRegion.y) & 0x3FF) << 10 |
+         (static_cast<Uint32>(frame) & 0xFFF) << 20;
+}
+
+void AnimatedSprite::Draw(SDL_Renderer *const sdlRenderer,
+                          const unsigned int tick) {
+  if (!_isPaused)
+    SetFrame(GetFrameAt(tick));
+  Sprite::Draw(sdlRenderer);
+}
+
+void AnimatedSprite::Capture(RenderState &state, const unsigned int tick) {
+  if (!_isPaused)
+    SetFrame(GetFrameAt(tick));
+  Sprite::Capture(state);
+}
+
+int AnimatedSprite::GetFrameAt(const unsigned int tick) const {
+  return static_cast<int>((tick - _startTick) / _frameDelay %
+                          static_cast<unsigned int>(_frameCount));
 }
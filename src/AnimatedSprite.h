@@ -26,10 +26,11 @@ class AnimatedSprite : public Sprite {
   unsigned int _frameDelay;
 
   /**
-   * `_frameTick`
-   *   The number of ticks since the last frame update.
+   * `_startTick`
+   *
+   *   The clock tick at which the first frame of the animation was shown.
    */
-  unsigned int _frameTick;
+  unsigned int _startTick;
 
   /**
    * `_frameCount`
@@ -155,12 +156,54 @@ public:
   void SetFramesRegionSize(const int height, const int width);
 
   /**
-   * `Update`
+   * `SetStartTick`
+   *
+   *   Sets the clock tick at which the first frame of the animation is shown.
+   */
+  void SetStartTick(const unsigned int value);
+
+  /**
+   * `GetStartTick`
+   *
+   *   Gets the clock tick at which the first frame of the animation is shown.
+   */
+  unsigned int GetStartTick() const;
+
+  /**
+   * `GetFrameKey`
    *
-   *   Updates the animated sprite.
+   *   Gets a value that identifies the frame drawn at the given clock tick.
+   */
+  Uint32 GetFrameKey(const unsigned int tick) const;
+
+  using Sprite::Draw;
+
+  /**
+   * `Draw`
+   *
+   *   Draws the sprite on the given renderer at the given clock tick.
+   *
+   * @description
+   *   The current frame of a playing sprite is derived from the clock, so
+   *   sprites that are not drawn cost nothing to animate.
+   */
+  void Draw(SDL_Renderer *const sdlRenderer, const unsigned int tick);
+
+  using Sprite::Capture;
+
+  /**
+   * `Capture`
+   *
+   *   Adds the sprite to the given render state as it is drawn at the given
+   *   clock tick.
+   */
+  void Capture(RenderState &state, const unsigned int tick);
+
+private:
+  /**
+   * `GetFrameAt`
    *
-   * @param dt
-   *   The change in ticks since the last update.
+   *   Gets the frame of a playing sprite at the given clock tick.
    */
-  void Update(unsigned int dt);
+  int GetFrameAt(const unsigned int tick) const;
 };
@@ -0,0 +1,76 @@
+/*******************************************************************************
+@file `AssignmentSolver.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "AssignmentSolver.h"
+#include <limits>
+
+void AssignmentSolver::Solve(const std::vector<int> &cost, int rows, int cols,
+                             std::vector<int> &assignment) {
+  const long long inf = std::numeric_limits<long long>::max() / 2;
+
+  // The algorithm requires no more rows than columns; transpose if needed.
+  bool transpose = rows > cols;
+  int n = transpose ? cols : rows;
+  int m = transpose ? rows : cols;
+  auto at = [&](int i, int j) -> long long {
+    return transpose ? cost[j * cols + i] : cost[i * cols + j];
+  };
+
+  u.assign(n + 1, 0);
+  v.assign(m + 1, 0);
+  match.assign(m + 1, 0);
+  way.assign(m + 1, 0);
+  for (int i = 1; i <= n; i++) {
+    match[0] = i;
+    int j0 = 0;
+    minv.assign(m + 1, inf);
+    used.assign(m + 1, 0);
+    do {
+      used[j0] = 1;
+      int i0 = match[j0];
+      int j1 = 0;
+      long long delta = inf;
+      for (int j = 1; j <= m; j++) {
+        if (used[j])
+          continue;
+        long long reduced = at(i0 - 1, j - 1) - u[i0] - v[j];
+        if (reduced < minv[j]) {
+          minv[j] = reduced;
+          way[j] = j0;
+        }
+        if (minv[j] < delta) {
+          delta = minv[j];
+          j1 = j;
+        }
+      }
+      for (int j = 0; j <= m; j++) {
+        if (used[j]) {
+          u[match[j]] += delta;
+          v[j] -= delta;
+        } else
+          minv[j] -= delta;
+      }
+      j0 = j1;
+    } while (match[j0] != 0);
+    do {
+      int j1 = way[j0];
+      match[j0] = match[j1];
+      j0 = j1;
+    } while (j0 != 0);
+  }
+
+  assignment.assign(rows, -1);
+  for (int j = 1; j <= m; j++) {
+    if (match[j] == 0)
+      continue;
+    if (transpose)
+      assignment[j - 1] = match[j] - 1;
+    else
+      assignment[match[j] - 1] = j - 1;
+  }
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+@file `AssignmentSolver.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+/**
+ * `AssignmentSolver`
+ *
+ *   Solves the rectangular assignment problem using the Hungarian algorithm.
+ *
+ * @description
+ *   Given a cost matrix of `rows` agents by `cols` tasks, each agent is
+ *   assigned at most one task and each task at most one agent so that the
+ *   total cost of the assignment is minimal. When there are more agents than
+ *   tasks, some agents are left unassigned, and vice versa.
+ *
+ *   The solver keeps its working buffers between calls so that solving once
+ *   per update does not reallocate.
+ */
+class AssignmentSolver {
+
+  /**
+   * `u`, `v`
+   *
+   *   The row and column potentials.
+   */
+  std::vector<long long> u;
+  std::vector<long long> v;
+
+  /**
+   * `minv`
+   *
+   *   The minimum reduced cost to reach each column in the current phase.
+   */
+  std::vector<long long> minv;
+
+  /**
+   * `match`
+   *
+   *   The row matched to each column; zero if unmatched.
+   */
+  std::vector<int> match;
+
+  /**
+   * `way`
+   *
+   *   The previous column on the augmenting path to each column.
+   */
+  std::vector<int> way;
+
+  /**
+   * `used`
+   *
+   *   Whether or not each column has been visited in the current phase.
+   */
+  std::vector<char> used;
+
+public:
+  /**
+   * `Solve`
+   *
+   *   Solves the assignment problem.
+   *
+   * @param cost
+   *   The row-major cost matrix.
+   *
+   * @param rows
+   *   The number of agents.
+   *
+   * @param cols
+   *   The number of tasks.
+   *
+   * @param assignment
+   *   Receives the task assigned to each agent, or -1 if the agent was not
+   *   assigned a task.
+   */
+  void Solve(const std::vector<int> &cost, int rows, int cols,
+             std::vector<int> &assignment);
+};
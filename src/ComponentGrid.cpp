@@ -0,0 +1,88 @@
+/*******************************************************************************
+@file `ComponentGrid.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "ComponentGrid.h"
+#include <algorithm>
+#include <cstddef>
+
+static int findRoot(std::vector<int> &parents, int label) {
+  while (parents[label] != label) {
+    parents[label] = parents[parents[label]];
+    label = parents[label];
+  }
+  return label;
+}
+
+ComponentGrid::ComponentGrid(SDL_Point mapSize)
+    : size(mapSize), labels(static_cast<std::size_t>(mapSize.x) * mapSize.y, 0),
+      roots(1, 0) {}
+
+void ComponentGrid::Label(const std::vector<char> &blocked) {
+  // The neighbors labeled before a tile: the one to its left and the three
+  // above it.
+  static const int offsets[4][2] = {{-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+  std::vector<int> parents;
+  labels.assign(blocked.size(), -1);
+  for (int y = 0; y < size.y; y++) {
+    for (int x = 0; x < size.x; x++) {
+      if (blocked[y * size.x + x])
+        continue;
+      int label = -1;
+      for (const int *offset : offsets) {
+        SDL_Point neighbor = {x + offset[0], y + offset[1]};
+        int other = GetLabel(neighbor);
+        if (other < 0)
+          continue;
+        other = findRoot(parents, other);
+        if (label < 0)
+          label = other;
+        else if (other != label) {
+          // The larger root joins the smaller one.
+          parents[std::max(label, other)] = std::min(label, other);
+          label = std::min(label, other);
+        }
+      }
+      if (label < 0) {
+        label = static_cast<int>(parents.size());
+        parents.push_back(label);
+      }
+      labels[y * size.x + x] = label;
+    }
+  }
+  roots.resize(parents.size());
+  for (std::size_t i = 0; i < parents.size(); i++)
+    roots[i] = findRoot(parents, static_cast<int>(i));
+}
+
+void ComponentGrid::Unblock(SDL_Point p) {
+  if (p.x < 0 || p.y < 0 || p.x >= size.x || p.y >= size.y ||
+      GetLabel(p) >= 0)
+    return;
+  std::vector<int> touched;
+  for (int dy = -1; dy <= 1; dy++) {
+    for (int dx = -1; dx <= 1; dx++) {
+      SDL_Point neighbor = {p.x + dx, p.y + dy};
+      int label = GetLabel(neighbor);
+      if (label >= 0)
+        touched.push_back(roots[label]);
+    }
+  }
+  if (touched.empty()) {
+    labels[p.y * size.x + p.x] = static_cast<int>(roots.size());
+    roots.push_back(static_cast<int>(roots.size()));
+    return;
+  }
+  // Every label of the touched components is given the smallest root, which
+  // keeps the roots flat.
+  int root = *std::min_element(touched.begin(), touched.end());
+  labels[p.y * size.x + p.x] = root;
+  for (int &r : roots) {
+    if (std::find(touched.begin(), touched.end(), r) != touched.end())
+      r = root;
+  }
+}
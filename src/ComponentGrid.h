@@ -0,0 +1,93 @@
+/*******************************************************************************
+@file `ComponentGrid.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * `ComponentGrid`
+ *
+ *   Labels the walkable tiles of a map by the connected component they belong
+ *   to, so that whether one tile can be reached from another is known without
+ *   a search.
+ *
+ * @description
+ *   Tiles are connected to all eight neighbors, like the steps of the robots.
+ *   The map is labeled in a single row-major pass that merges the labels of
+ *   touching tiles with a union-find. The roots are then flattened, so
+ *   queries only read two entries and are safe from several threads.
+ *
+ *   Unblocking a tile only merges the components around it. Blocking a tile
+ *   may split a component, and the map is labeled again.
+ */
+class ComponentGrid {
+
+  /**
+   * `size`
+   *
+   *   The width and height of the map in tiles.
+   */
+  SDL_Point size;
+
+  /**
+   * `labels`
+   *
+   *   The label of each tile, row by row, or -1 for a blocked tile.
+   */
+  std::vector<int> labels;
+
+  /**
+   * `roots`
+   *
+   *   The label of the component each label belongs to.
+   */
+  std::vector<int> roots;
+
+public:
+  /**
+   * `ComponentGrid`
+   *
+   *   Constructor. Every tile starts walkable and in one component.
+   */
+  ComponentGrid(SDL_Point mapSize);
+
+  /**
+   * `Label`
+   *
+   *   Labels the whole map from its blocked tiles, row by row.
+   */
+  void Label(const std::vector<char> &blocked);
+
+  /**
+   * `Unblock`
+   *
+   *   Labels a tile that became walkable, merging the components it touches.
+   */
+  void Unblock(SDL_Point p);
+
+  /**
+   * `IsConnected`
+   *
+   *   True if both points are walkable and in the same component; otherwise,
+   *   false.
+   */
+  bool IsConnected(SDL_Point a, SDL_Point b) const {
+    int labelA = GetLabel(a);
+    int labelB = GetLabel(b);
+    return labelA >= 0 && labelB >= 0 && roots[labelA] == roots[labelB];
+  }
+
+private:
+  int GetLabel(SDL_Point p) const {
+    return p.x >= 0 && p.y >= 0 && p.x < size.x && p.y < size.y
+               ? labels[p.y * size.x + p.x]
+               : -1;
+  }
+};
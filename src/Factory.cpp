@@ -7,6 +7,47 @@
 *******************************************************************************/
 
 #include "Factory.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include <algorithm>
+#include <climits>
+
+/**
+ * `CANDIDATE_GRID_CELL_SIZE`
+ *
+ *   The height and width in factory tiles of each candidate grid cell.
+ */
+#define CANDIDATE_GRID_CELL_SIZE 4
+
+/**
+ * `UNREACHABLE_COST`
+ *
+ *   The assignment cost of a target with no path.
+ */
+#define UNREACHABLE_COST 0x3FFFFFFF
+
+/**
+ * `DEFAULT_CANDIDATE_COUNT`
+ *
+ *   The number of nearest candidates a robot picks its target from unless set
+ *   otherwise.
+ */
+#define DEFAULT_CANDIDATE_COUNT 8
+
+/**
+ * `ROBOT_CHUNK_SIZE`
+ *
+ *   The number of robots advanced at a time by each thread.
+ */
+#define ROBOT_CHUNK_SIZE 64
+
+/**
+ * `MAX_DIRTY_REGIONS`
+ *
+ *   The most dirty regions redrawn separately before they are merged into their
+ *   bounding region.
+ */
+#define MAX_DIRTY_REGIONS 32
 
 static SDL_Rect makeRect(int x, int y, int w, int h) {
   SDL_Rect r;
@@ -24,12 +65,32 @@ static SDL_Point makePoint(int x, int y) {
   return p;
 }
 
+static bool isVisible(Machine *m, const SDL_Rect &viewport) {
+  return SDL_HasIntersection(&m->GetMachineSprite().GetDrawRegion(),
+                             &viewport) == SDL_TRUE;
+}
+
+static bool isSameRect(const SDL_Rect &lhs, const SDL_Rect &rhs) {
+  return lhs.x == rhs.x && lhs.y == rhs.y && lhs.w == rhs.w && lhs.h == rhs.h;
+}
+
 Factory::Factory(SDL_Texture *factorySpritesheet, int x, int y, int width,
                  int height)
     : spritesheet(factorySpritesheet),
       tile(
           Sprite(spritesheet, makeRect(16, 0, 16, 16), makeRect(0, 0, 32, 32))),
-      drawPoint(makePoint(x, y)), factorySize(makePoint(width, height)) {}
+      drawPoint(makePoint(x, y)), factorySize(makePoint(width, height)),
+      blocked(static_cast<std::size_t>(width) * height, 0),
+      components(factorySize),
+      walkableGrid(factorySize, blocked, &components),
+      clock(0), elapsed(0),
+      candidateConsumerGrid(width, height, CANDIDATE_GRID_CELL_SIZE),
+      candidateProducerGrid(width, height, CANDIDATE_GRID_CELL_SIZE),
+      threadPool(new ThreadPool(1)), isBatchedAssignment(false),
+      isProducerAssignmentDirty(false), isConsumerAssignmentDirty(false),
+      isPipelinedPlanning(false), anytimeBudget(0), isDeferringEvents(false),
+      isHandlingEvent(false), pathService(walkableGrid),
+      candidateCount(DEFAULT_CANDIDATE_COUNT), isDrawValid(false) {}
 
 Factory::~Factory() {
   for (ConsumerMachine *c : consumers)
@@ -38,97 +99,699 @@ Factory::~Factory() {
     delete p;
   for (RobotMachine *r : robots)
     delete r;
+  delete threadPool;
 }
 
 void Factory::Update(unsigned int dt) {
-  for (ConsumerMachine *c : consumers)
-    c->Update(dt);
-  for (ProducerMachine *p : producers)
-    p->Update(dt);
+  ProfileScope updateScope(ProfileZone::Update);
+  TraceScope traceScope("Factory::Update");
+  clock += dt;
+  elapsed += dt;
+  UpdateStations();
+  UpdateRobots();
+  DrainEvents();
+  if (isBatchedAssignment) {
+    ProfileScope assignmentScope(ProfileZone::Assignment);
+    AssignTargets(true);
+    AssignTargets(false);
+  }
+  DrainEvents();
+  if (Trace::IsEnabled())
+    TraceCounters();
+}
+
+void Factory::TraceCounters() {
+  long long searches = 0;
+  long long openSetSize = 0;
   for (RobotMachine *r : robots) {
-    r->Update(dt);
-    double progress = r->GetStepProgress();
-    SDL_Point p = r->GetFactoryPoint();
-    SDL_Point q = r->GetStep();
-    q.x -= p.x;
-    q.y -= p.y;
-    r->SetDrawPoint(drawPoint.x + (p.x + (double)q.x * progress) * 32,
-                    drawPoint.y + (p.y + (double)q.y * progress) * 16);
+    searches += r->IsPickingTarget() ? 1 : 0;
+    openSetSize += r->IsPickingTarget() ? r->GetSearchOpenSetSize() : 0;
   }
+  Trace::Counter("Searches in flight", searches);
+  Trace::Counter("Open set size", openSetSize);
+  Trace::Counter("Candidate producers", candidateProducers.size());
+  Trace::Counter("Candidate consumers", candidateConsumers.size());
+}
+
+void Factory::UpdateStations() {
+  ProfileScope scope(ProfileZone::Stations);
+  while (!schedule.empty() &&
+         static_cast<int>(schedule.top().tick - clock) <= 0) {
+    Machine *m = schedule.top().machine;
+    schedule.pop();
+    m->UpdateTo(clock);
+  }
+}
+
+void Factory::UpdateRobots() {
+  ProfileScope scope(ProfileZone::Robots);
+  threadPool->ParallelFor(
+      robots.size(), ROBOT_CHUNK_SIZE,
+      [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+          RobotMachine *r = robots[i];
+          r->Advance(clock);
+          double progress = r->GetStepProgress();
+          SDL_Point p = r->GetFactoryPoint();
+          SDL_Point q = r->GetStep();
+          q.x -= p.x;
+          q.y -= p.y;
+          r->SetDrawPoint(drawPoint.x + (p.x + (double)q.x * progress) * 32,
+                          drawPoint.y + (p.y + (double)q.y * progress) * 16);
+        }
+      });
+  for (RobotMachine *r : robots)
+    r->CommitEvents();
 }
 
 void Factory::Draw(SDL_Renderer *sdlRenderer) {
-  for (int i = 0; i < factorySize.x; i++) {
-    for (int j = 0; j < (factorySize.y + 1) / 2; j++) {
+  SDL_Rect viewport;
+  SDL_RenderGetViewport(sdlRenderer, &viewport);
+  viewport.x = 0;
+  viewport.y = 0;
+  Draw(sdlRenderer, viewport);
+}
+
+void Factory::Draw(SDL_Renderer *sdlRenderer, const SDL_Rect &region) {
+  ProfileScope scope(ProfileZone::Draw);
+  TraceScope traceScope("Factory::Draw");
+  int left = std::max(0, (region.x - drawPoint.x) / 32);
+  int right =
+      std::min(factorySize.x, (region.x + region.w - drawPoint.x + 31) / 32);
+  int top = std::max(0, (region.y - drawPoint.y) / 32);
+  int bottom = std::min((factorySize.y + 1) / 2,
+                        (region.y + region.h - drawPoint.y + 31) / 32);
+  for (int i = left; i < right; i++) {
+    for (int j = top; j < bottom; j++) {
       tile.SetDrawRegionPoint(drawPoint.x + i * 32, drawPoint.y + j * 32);
       tile.Draw(sdlRenderer);
     }
   }
-  for (ConsumerMachine *c : consumers)
-    c->Draw(sdlRenderer);
-  for (ProducerMachine *p : producers)
-    p->Draw(sdlRenderer);
-  for (RobotMachine *r : robots)
-    r->Draw(sdlRenderer);
+  DrawBlocked(sdlRenderer, region);
+  // Animation frames are derived from the clock when drawn, so machines
+  // outside of the region are skipped entirely.
+  for (ConsumerMachine *c : consumers) {
+    if (isVisible(c, region))
+      c->Draw(sdlRenderer, clock);
+  }
+  for (ProducerMachine *p : producers) {
+    if (isVisible(p, region))
+      p->Draw(sdlRenderer, clock);
+  }
+  for (RobotMachine *r : robots) {
+    if (isVisible(r, region))
+      r->Draw(sdlRenderer, clock);
+  }
+}
+
+void Factory::Capture(RenderState &state, const SDL_Rect &region) {
+  ProfileScope scope(ProfileZone::Draw);
+  TraceScope traceScope("Factory::Capture");
+  state.Clear();
+  int left = std::max(0, (region.x - drawPoint.x) / 32);
+  int right =
+      std::min(factorySize.x, (region.x + region.w - drawPoint.x + 31) / 32);
+  int top = std::max(0, (region.y - drawPoint.y) / 32);
+  int bottom = std::min((factorySize.y + 1) / 2,
+                        (region.y + region.h - drawPoint.y + 31) / 32);
+  for (int i = left; i < right; i++) {
+    for (int j = top; j < bottom; j++) {
+      tile.SetDrawRegionPoint(drawPoint.x + i * 32, drawPoint.y + j * 32);
+      state.AddFloor(spritesheet, tile.GetSpriteRegion(),
+                     tile.GetDrawRegion());
+    }
+  }
+  top = std::max(0, (region.y - drawPoint.y - 16) / 16);
+  bottom = std::min(factorySize.y,
+                    (region.y + region.h - drawPoint.y - 16 + 15) / 16);
+  for (int y = top; y < bottom; y++) {
+    for (int x = left; x < right; x++) {
+      if (blocked[y * factorySize.x + x])
+        state.AddBlocked(
+            makeRect(drawPoint.x + x * 32, drawPoint.y + y * 16 + 16, 32, 16));
+    }
+  }
+  for (ConsumerMachine *c : consumers) {
+    if (isVisible(c, region))
+      c->Capture(state, clock);
+  }
+  for (ProducerMachine *p : producers) {
+    if (isVisible(p, region))
+      p->Capture(state, clock);
+  }
+  for (RobotMachine *r : robots) {
+    if (isVisible(r, region))
+      r->Capture(state, clock);
+  }
+}
+
+unsigned int Factory::GetIdleTicks() {
+  for (RobotMachine *r : robots) {
+    if (r->HasTarget() || !r->IsIdle())
+      return 0;
+    // A candidate walled off from the robot does not wake it.
+    SDL_Point p = r->GetFactoryPoint();
+    for (StructureMachine *c :
+         r->IsEmpty() ? candidateProducers : candidateConsumers) {
+      if (walkableGrid.IsConnected(p, c->GetFactoryPoint()))
+        return 0;
+    }
+  }
+  if (schedule.empty())
+    return UINT_MAX;
+  int ticks = static_cast<int>(schedule.top().tick - clock);
+  return ticks > 0 ? ticks : 0;
+}
+
+void Factory::FindDirtyRegions(const SDL_Rect &viewport,
+                               std::vector<SDL_Rect> &regions) {
+  ProfileScope scope(ProfileZone::Draw);
+  regions.clear();
+  if (drawnMachines.size() != machines.size()) {
+    drawnMachines.resize(machines.size());
+    isDrawValid = false;
+  }
+  for (std::size_t i = 0; i < machines.size(); i++) {
+    Machine *m = machines[i];
+    const SDL_Rect &region = m->GetMachineSprite().GetDrawRegion();
+    Uint64 key = m->GetDrawKey(clock);
+    DrawnMachine &drawn = drawnMachines[i];
+    if (key == drawn.key && isSameRect(region, drawn.region))
+      continue;
+    SDL_Rect dirty;
+    if (isDrawValid) {
+      if (SDL_IntersectRect(&drawn.region, &viewport, &dirty) == SDL_TRUE)
+        regions.push_back(dirty);
+      if (SDL_IntersectRect(&region, &viewport, &dirty) == SDL_TRUE)
+        regions.push_back(dirty);
+    }
+    drawn.region = region;
+    drawn.key = key;
+  }
+  if (!isDrawValid) {
+    regions.push_back(viewport);
+    isDrawValid = true;
+  } else if (regions.size() > MAX_DIRTY_REGIONS) {
+    SDL_Rect bounds = regions[0];
+    for (const SDL_Rect &r : regions)
+      SDL_UnionRect(&bounds, &r, &bounds);
+    regions.assign(1, bounds);
+  }
+}
+
+void Factory::Load(const FactoryLayout &layout) {
+  // The components are labeled once for the whole layout rather than for
+  // each blocked tile.
+  for (int y = 0; y < std::min(layout.height, factorySize.y); y++) {
+    for (int x = 0; x < std::min(layout.width, factorySize.x); x++) {
+      if (layout.blocked[y * layout.width + x])
+        blocked[y * factorySize.x + x] = 1;
+    }
+  }
+  components.Label(blocked);
+  consumers.reserve(consumers.size() + layout.consumers.size());
+  producers.reserve(producers.size() + layout.producers.size());
+  robots.reserve(robots.size() + layout.robots.size());
+  machines.reserve(machines.size() + layout.consumers.size() +
+                   layout.producers.size() + layout.robots.size());
+  for (const FactoryLayout::Station &s : layout.consumers) {
+    if (IsWalkable(s.point))
+      AddConsumerMachine(s.point.x, s.point.y, s.busyDelay);
+  }
+  for (const FactoryLayout::Station &s : layout.producers) {
+    if (IsWalkable(s.point))
+      AddProducerMachine(s.point.x, s.point.y, s.busyDelay);
+  }
+  for (const SDL_Point &p : layout.robots) {
+    if (IsWalkable(p))
+      AddRobotMachine(p.x, p.y);
+  }
+}
+
+static void saveMachines(Snapshot &snapshot,
+                         const std::list<StructureMachine *> &list) {
+  snapshot.Write(static_cast<Uint64>(list.size()));
+  for (StructureMachine *m : list)
+    snapshot.WriteMachine(m);
+}
+
+static void saveMachines(Snapshot &snapshot,
+                         const std::vector<RobotMachine *> &list) {
+  snapshot.Write(static_cast<Uint64>(list.size()));
+  for (RobotMachine *r : list)
+    snapshot.WriteMachine(r);
+}
+
+static void restoreMachines(Snapshot &snapshot,
+                            std::list<StructureMachine *> &list) {
+  std::size_t count = snapshot.ReadCount(sizeof(Sint32));
+  list.clear();
+  for (std::size_t n = 0; n < count; n++)
+    list.push_back(static_cast<StructureMachine *>(snapshot.ReadMachine()));
+}
+
+static void restoreMachines(Snapshot &snapshot,
+                            std::vector<RobotMachine *> &list) {
+  std::size_t count = snapshot.ReadCount(sizeof(Sint32));
+  list.clear();
+  for (std::size_t n = 0; n < count; n++)
+    list.push_back(static_cast<RobotMachine *>(snapshot.ReadMachine()));
+}
+
+void Factory::Save(Snapshot &snapshot) const {
+  snapshot.Write(factorySize);
+  snapshot.Write(static_cast<Uint64>(consumers.size()));
+  snapshot.Write(static_cast<Uint64>(producers.size()));
+  snapshot.Write(static_cast<Uint64>(robots.size()));
+  snapshot.Write(clock);
+  snapshot.Write(elapsed);
+  snapshot.WriteVector(blocked);
+
+  // The heap is saved in its array order so that machines due at the same
+  // tick are updated in the same order after restoring.
+  const std::vector<ScheduledMachine> &scheduled = schedule.container();
+  snapshot.Write(static_cast<Uint64>(scheduled.size()));
+  for (const ScheduledMachine &item : scheduled) {
+    snapshot.Write(item.tick);
+    snapshot.WriteMachine(item.machine);
+  }
+
+  saveMachines(snapshot, candidateConsumers);
+  saveMachines(snapshot, candidateProducers);
+  snapshot.Write(isBatchedAssignment);
+  saveMachines(snapshot, waitingEmptyRobots);
+  saveMachines(snapshot, waitingFullRobots);
+  snapshot.Write(isProducerAssignmentDirty);
+  snapshot.Write(isConsumerAssignmentDirty);
+  for (Machine *m : machines)
+    m->Save(snapshot);
 }
 
-void Factory::AddConsumerMachine(int x, int y) {
+bool Factory::Restore(Snapshot &snapshot) {
+  snapshot.Rewind();
+  snapshot.SetMachines(&machines);
+  SDL_Point size;
+  Uint64 consumerCount, producerCount, robotCount;
+  snapshot.Read(size);
+  snapshot.Read(consumerCount);
+  snapshot.Read(producerCount);
+  snapshot.Read(robotCount);
+  if (!snapshot.IsValid() || size.x != factorySize.x ||
+      size.y != factorySize.y || consumerCount != consumers.size() ||
+      producerCount != producers.size() || robotCount != robots.size()) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR,
+                 "Snapshot does not match the factory layout\n");
+    return false;
+  }
+  snapshot.Read(clock);
+  snapshot.Read(elapsed);
+  snapshot.ReadVector(blocked);
+
+  std::vector<ScheduledMachine> &scheduled = schedule.container();
+  std::size_t count = snapshot.ReadCount(sizeof(Uint32) + sizeof(Sint32));
+  scheduled.resize(count);
+  for (ScheduledMachine &item : scheduled) {
+    snapshot.Read(item.tick);
+    item.machine = snapshot.ReadMachine();
+  }
+
+  restoreMachines(snapshot, candidateConsumers);
+  restoreMachines(snapshot, candidateProducers);
+  snapshot.Read(isBatchedAssignment);
+  restoreMachines(snapshot, waitingEmptyRobots);
+  restoreMachines(snapshot, waitingFullRobots);
+  snapshot.Read(isProducerAssignmentDirty);
+  snapshot.Read(isConsumerAssignmentDirty);
+  for (Machine *m : machines)
+    m->Restore(snapshot);
+
+  // The spatial indices only answer queries, so they are rebuilt from the
+  // candidate lists rather than saved.
+  candidateConsumerGrid =
+      MachineGrid(factorySize.x, factorySize.y, CANDIDATE_GRID_CELL_SIZE);
+  candidateProducerGrid =
+      MachineGrid(factorySize.x, factorySize.y, CANDIDATE_GRID_CELL_SIZE);
+  for (StructureMachine *m : candidateConsumers)
+    candidateConsumerGrid.Insert(m);
+  for (StructureMachine *m : candidateProducers)
+    candidateProducerGrid.Insert(m);
+
+  bool isValid =
+      snapshot.IsValid() &&
+      blocked.size() == static_cast<std::size_t>(factorySize.x) * factorySize.y;
+  if (!isValid)
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Snapshot is truncated\n");
+  else
+    components.Label(blocked);
+  return isValid;
+}
+
+void Factory::SetBlocked(int x, int y, bool value) {
+  if (x < 0 || y < 0 || x >= factorySize.x || y >= factorySize.y ||
+      (blocked[y * factorySize.x + x] != 0) == value)
+    return;
+  blocked[y * factorySize.x + x] = value ? 1 : 0;
+  // A new wall may split a component; an opening can only join components.
+  if (value)
+    components.Label(blocked);
+  else
+    components.Unblock(makePoint(x, y));
+}
+
+void Factory::DrawBlocked(SDL_Renderer *sdlRenderer, const SDL_Rect &region) {
+  int left = std::max(0, (region.x - drawPoint.x) / 32);
+  int right =
+      std::min(factorySize.x, (region.x + region.w - drawPoint.x + 31) / 32);
+  int top = std::max(0, (region.y - drawPoint.y - 16) / 16);
+  int bottom = std::min(factorySize.y,
+                        (region.y + region.h - drawPoint.y - 16 + 15) / 16);
+  Uint8 r, g, b, a;
+  SDL_GetRenderDrawColor(sdlRenderer, &r, &g, &b, &a);
+  SDL_SetRenderDrawColor(sdlRenderer, 0x30, 0x30, 0x30, 0xFF);
+  for (int y = top; y < bottom; y++) {
+    for (int x = left; x < right; x++) {
+      if (blocked[y * factorySize.x + x]) {
+        SDL_Rect rect =
+            makeRect(drawPoint.x + x * 32, drawPoint.y + y * 16 + 16, 32, 16);
+        SDL_RenderFillRect(sdlRenderer, &rect);
+      }
+    }
+  }
+  SDL_SetRenderDrawColor(sdlRenderer, r, g, b, a);
+}
+
+void Factory::AddConsumerMachine(int x, int y, unsigned int busyDelay) {
   ConsumerMachine *c = new ConsumerMachine(
       spritesheet, makeRect(drawPoint.x + x * 32, drawPoint.y + y * 16, 32, 32),
-      makePoint(x, y));
+      makePoint(x, y), busyDelay);
+  c->SetUpdateTick(clock);
   c->AddIsIdleChangedEventHandler([this](EventPayload<Machine> &payload) {
-    this->ConsumerIsIdleChanged(payload);
+    this->QueueEvent(FactoryEvent::ConsumerIsIdleChanged, payload.source);
   });
+  AddMachine(c);
   consumers.push_back(c);
   candidateConsumers.push_back(c);
+  candidateConsumerGrid.Insert(c);
 }
 
-void Factory::AddProducerMachine(int x, int y) {
+void Factory::AddProducerMachine(int x, int y, unsigned int busyDelay) {
   ProducerMachine *p = new ProducerMachine(
       spritesheet, makeRect(drawPoint.x + x * 32, drawPoint.y + y * 16, 32, 32),
-      makePoint(x, y));
+      makePoint(x, y), busyDelay);
+  p->SetUpdateTick(clock);
   p->AddIsIdleChangedEventHandler([this](EventPayload<Machine> &payload) {
-    this->ProducerIsIdleChanged(payload);
+    this->QueueEvent(FactoryEvent::ProducerIsIdleChanged, payload.source);
   });
+  AddMachine(p);
   producers.push_back(p);
   candidateProducers.push_back(p);
+  candidateProducerGrid.Insert(p);
 }
 
 void Factory::AddRobotMachine(int x, int y) {
   RobotMachine *r = new RobotMachine(
       spritesheet, makeRect(drawPoint.x + x * 32, drawPoint.y + y * 16, 32, 32),
-      makePoint(x, y));
-  EventPayload<RobotMachine> payload(r);
+      makePoint(x, y), walkableGrid);
+  r->SetAnytimeBudget(anytimeBudget);
+  r->SetUpdateTick(clock);
   r->AddHasTargetChangedEventHandler(
       [this](EventPayload<RobotMachine> &payload) {
-        this->HasTargetChanged(payload);
+        this->QueueEvent(FactoryEvent::HasTargetChanged, payload.source);
       });
-  r->PickTarget(candidateProducers);
+  // The robot asks for a target at its first update, so adding many robots
+  // does not start a search for each of them here.
+  AddMachine(r);
   robots.push_back(r);
 }
 
+void Factory::AddMachine(Machine *machine) {
+  machine->SetId(machines.size());
+  machines.push_back(machine);
+  isEventQueued.push_back(0);
+}
+
+void Factory::SetDeferredEvents(bool value) {
+  if (!value)
+    DrainEvents();
+  isDeferringEvents = value;
+}
+
+void Factory::QueueEvent(FactoryEvent event, Machine *source) {
+  if (!isDeferringEvents)
+    HandleEvent(event, source);
+  else if (!isEventQueued[source->GetId()]) {
+    isEventQueued[source->GetId()] = 1;
+    QueuedEvent queued;
+    queued.event = event;
+    queued.source = source;
+    queuedEvents.push_back(queued);
+  }
+}
+
+void Factory::HandleEvent(FactoryEvent event, Machine *source) {
+  if (isHandlingEvent) {
+    DispatchEvent(event, source);
+    return;
+  }
+  ProfileScope scope(ProfileZone::Events);
+  isHandlingEvent = true;
+  DispatchEvent(event, source);
+  isHandlingEvent = false;
+}
+
+void Factory::DispatchEvent(FactoryEvent event, Machine *source) {
+  switch (event) {
+  case FactoryEvent::ConsumerIsIdleChanged: {
+    EventPayload<Machine> payload(source);
+    ConsumerIsIdleChanged(payload);
+    break;
+  }
+  case FactoryEvent::ProducerIsIdleChanged: {
+    EventPayload<Machine> payload(source);
+    ProducerIsIdleChanged(payload);
+    break;
+  }
+  case FactoryEvent::HasTargetChanged: {
+    EventPayload<RobotMachine> payload(static_cast<RobotMachine *>(source));
+    HasTargetChanged(payload);
+    break;
+  }
+  }
+}
+
+void Factory::DrainEvents() {
+  TraceScope traceScope("Factory::DrainEvents");
+  // Handlers may queue further events, which are handled in the same pass.
+  for (std::size_t i = 0; i < queuedEvents.size(); i++) {
+    QueuedEvent queued = queuedEvents[i];
+    isEventQueued[queued.source->GetId()] = 0;
+    HandleEvent(queued.event, queued.source);
+  }
+  queuedEvents.clear();
+}
+
+void Factory::AddCandidate(StructureMachine *machine, bool isProducer) {
+  (isProducer ? candidateProducers : candidateConsumers).push_back(machine);
+  (isProducer ? candidateProducerGrid : candidateConsumerGrid).Insert(machine);
+  (isProducer ? isProducerAssignmentDirty : isConsumerAssignmentDirty) = true;
+  for (RobotMachine *r : robots) {
+    if (r->IsPickingTarget() && r->IsPickingProducers() == isProducer)
+      r->AddCandidate(machine);
+  }
+}
+
+void Factory::RemoveCandidate(StructureMachine *machine, bool isProducer) {
+  (isProducer ? candidateProducers : candidateConsumers).remove(machine);
+  for (RobotMachine *r : robots) {
+    if (r->IsPickingProducers() != isProducer)
+      continue;
+    if (r->IsPickingTarget())
+      r->RemoveCandidate(machine);
+    else if (r->IsPlanningNextLeg() && r->GetNextTarget() == machine)
+      // The planned next target is only claimed once the robot is done with
+      // its current one, so a plan overtaken meanwhile is made again.
+      r->PlanNextLeg(
+          FindPickCandidates(r->GetTarget()->GetFactoryPoint(), isProducer));
+  }
+}
+
+void Factory::SetThreadCount(unsigned int value) {
+  delete threadPool;
+  threadPool = new ThreadPool(value);
+}
+
+void Factory::SetPipelinedPlanning(bool value) { isPipelinedPlanning = value; }
+
+void Factory::SetAnytimeBudget(unsigned int value) {
+  anytimeBudget = value;
+  for (RobotMachine *r : robots)
+    r->SetAnytimeBudget(value);
+}
+
+void Factory::SetBatchedAssignment(bool value) {
+  isBatchedAssignment = value;
+  // Robots left waiting pick their own target at their next update.
+  waitingEmptyRobots.clear();
+  waitingFullRobots.clear();
+  isProducerAssignmentDirty = value;
+  isConsumerAssignmentDirty = value;
+}
+
+void Factory::Schedule(Machine *machine) {
+  // The machine was idle and not being updated until it was restarted.
+  machine->SetUpdateTick(clock);
+  ScheduledMachine scheduled;
+  scheduled.tick = machine->GetIdleTick();
+  scheduled.machine = machine;
+  schedule.push(scheduled);
+}
+
 void Factory::HasTargetChanged(EventPayload<RobotMachine> &payload) {
   bool isEmpty = payload.source->IsEmpty();
-  std::list<StructureMachine *> *candidates =
-      isEmpty ? &candidateProducers : &candidateConsumers;
+  MachineGrid *grid =
+      isEmpty ? &candidateProducerGrid : &candidateConsumerGrid;
   if (payload.source->HasTarget()) {
-    candidates->remove(payload.source->GetTarget());
-    for (RobotMachine *r : robots) {
-      if (r->IsPickingTarget() && r->IsEmpty() == isEmpty)
-        r->PickTarget(*candidates);
+    StructureMachine *target = payload.source->GetTarget();
+    if (!grid->Remove(target)) {
+      // Another robot claimed the target first, so the robot picks again on
+      // its own rather than through the path service; see `PathService`.
+      payload.source->ClearTarget();
+      payload.source->PickTarget(
+          FindPickCandidates(payload.source->GetFactoryPoint(), isEmpty));
+      return;
+    } else
+      RemoveCandidate(target, isEmpty);
+    if (isPipelinedPlanning && !isBatchedAssignment)
+      payload.source->PlanNextLeg(FindPickCandidates(
+          payload.source->GetTarget()->GetFactoryPoint(), !isEmpty));
+  } else if (isBatchedAssignment) {
+    std::vector<RobotMachine *> &waiting =
+        isEmpty ? waitingEmptyRobots : waitingFullRobots;
+    if (std::find(waiting.begin(), waiting.end(), payload.source) ==
+        waiting.end()) {
+      waiting.push_back(payload.source);
+      (isEmpty ? isProducerAssignmentDirty : isConsumerAssignmentDirty) = true;
     }
   } else
-    payload.source->PickTarget(*candidates);
+    payload.source->PickTarget(
+        FindPickCandidates(payload.source->GetFactoryPoint(), isEmpty));
+}
+
+void Factory::AssignTargets(bool isEmpty) {
+  bool &isDirty =
+      isEmpty ? isProducerAssignmentDirty : isConsumerAssignmentDirty;
+  std::vector<RobotMachine *> &waiting =
+      isEmpty ? waitingEmptyRobots : waitingFullRobots;
+  std::list<StructureMachine *> &candidates =
+      isEmpty ? candidateProducers : candidateConsumers;
+  if (!isDirty || waiting.empty() || candidates.empty())
+    return;
+  isDirty = false;
+
+  // Build the cost matrix from the path costs of every robot to every
+  // candidate. The costs to each candidate come from a single search.
+  int rows = waiting.size();
+  int cols = candidates.size();
+  std::vector<StructureMachine *> targets(candidates.begin(), candidates.end());
+  std::vector<int> cost(rows * cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      int k = i * cols + j;
+      pathService.RequestCost(waiting[i]->GetFactoryPoint(), targets[j],
+                              [&cost, k](unsigned int pathCost) {
+                                cost[k] = pathCost == UINT_MAX
+                                              ? UNREACHABLE_COST
+                                              : static_cast<int>(pathCost);
+                              });
+    }
+  }
+  pathService.Solve();
+  std::vector<int> assignment;
+  assignmentSolver.Solve(cost, rows, cols, assignment);
+
+  // Only the paths of the assigned pairs are found, one search per target.
+  std::vector<std::vector<SDL_Point>> paths(rows);
+  for (int i = 0; i < rows; i++) {
+    int j = assignment[i];
+    if (j < 0 || cost[i * cols + j] == UNREACHABLE_COST)
+      continue;
+    pathService.Request(waiting[i]->GetFactoryPoint(), targets[j],
+                        [&paths, i](PathService::TargetPath &targetPath) {
+                          paths[i].swap(targetPath.second);
+                        });
+  }
+  pathService.Solve();
+
+  // Assigning a target emits `HasTargetChanged`, which removes the target from
+  // the candidates, so the waiting list is settled before assigning.
+  std::vector<RobotMachine *> robotsArg(waiting);
+  waiting.clear();
+  for (int i = 0; i < rows; i++) {
+    if (paths[i].empty())
+      waiting.push_back(robotsArg[i]);
+  }
+  for (int i = 0; i < rows; i++) {
+    if (!paths[i].empty())
+      robotsArg[i]->AssignTarget(targets[assignment[i]], paths[i]);
+  }
+}
+
+static void accumulate(MachineMetrics &total, const MachineMetrics &value) {
+  total.jobs += value.jobs;
+  total.busyTicks += value.busyTicks;
+  total.idleTicks += value.idleTicks;
+  total.steps += value.steps;
+}
+
+FactoryMetrics Factory::GetMetrics() {
+  FactoryMetrics metrics;
+  metrics.ticks = elapsed;
+  metrics.consumers = consumers.size();
+  metrics.producers = producers.size();
+  metrics.robots = robots.size();
+  for (ConsumerMachine *c : consumers)
+    accumulate(metrics.consumerTotals, c->GetMetrics());
+  for (ProducerMachine *p : producers)
+    accumulate(metrics.producerTotals, p->GetMetrics());
+  for (RobotMachine *r : robots)
+    accumulate(metrics.robotTotals, r->GetMetrics());
+  return metrics;
+}
+
+void Factory::FindNearestCandidates(SDL_Point origin, bool isEmpty,
+                                    std::size_t k,
+                                    std::vector<Machine *> &result) const {
+  // Unreachable candidates are skipped by the query rather than afterwards,
+  // so a walled-off cluster near the origin cannot crowd out the rest.
+  (isEmpty ? candidateProducerGrid : candidateConsumerGrid)
+      .Nearest(origin, k, result, [this, origin](SDL_Point p) {
+        return walkableGrid.IsConnected(origin, p);
+      });
+}
+
+std::list<StructureMachine *> Factory::FindPickCandidates(SDL_Point origin,
+                                                          bool isEmpty) {
+  std::list<StructureMachine *> &candidates =
+      isEmpty ? candidateProducers : candidateConsumers;
+  if (candidateCount == 0 || candidates.size() <= candidateCount)
+    return candidates;
+  FindNearestCandidates(origin, isEmpty, candidateCount, nearestCandidates);
+  std::list<StructureMachine *> nearest;
+  for (Machine *m : nearestCandidates)
+    nearest.push_back(static_cast<StructureMachine *>(m));
+  return nearest;
 }
 
 void Factory::ConsumerIsIdleChanged(EventPayload<Machine> &payload) {
   if (payload.source->IsIdle())
-    candidateConsumers.push_back(
-        dynamic_cast<StructureMachine *>(payload.source));
+    AddCandidate(dynamic_cast<StructureMachine *>(payload.source), false);
+  else
+    Schedule(payload.source);
 }
 
 void Factory::ProducerIsIdleChanged(EventPayload<Machine> &payload) {
   if (payload.source->IsIdle())
-    candidateProducers.push_back(
-        dynamic_cast<StructureMachine *>(payload.source));
+    AddCandidate(dynamic_cast<StructureMachine *>(payload.source), true);
+  else
+    Schedule(payload.source);
 }
@@ -8,12 +8,23 @@
 
 #pragma once
 
+#include "AssignmentSolver.h"
+#include "ComponentGrid.h"
 #include "ConsumerMachine.h"
+#include "FactoryLayout.h"
+#include "MachineGrid.h"
+#include "PathService.h"
 #include "ProducerMachine.h"
+#include "RenderState.h"
 #include "RobotMachine.h"
+#include "SearchPathAlgorithm.h"
+#include "Snapshot.h"
 #include "Sprite.h"
+#include "ThreadPool.h"
 #include <SDL2/SDL.h>
+#include <cstddef>
 #include <list>
+#include <queue>
 #include <vector>
 
 /**
@@ -23,6 +34,74 @@
  */
 class Factory {
 
+  /**
+   * `ScheduledMachine`
+   *
+   *   A busy machine and the factory tick at which it will become idle.
+   */
+  struct ScheduledMachine {
+    unsigned int tick;
+    Machine *machine;
+  };
+
+  /**
+   * `ScheduledMachineCompare`
+   *
+   *   Orders scheduled machines with the earliest tick on top. Ticks are
+   *   compared by their difference so that the order survives wraparound.
+   */
+  struct ScheduledMachineCompare {
+    bool operator()(const ScheduledMachine &lhs,
+                    const ScheduledMachine &rhs) const {
+      return static_cast<int>(lhs.tick - rhs.tick) > 0;
+    }
+  };
+
+  /**
+   * `ScheduleQueue`
+   *
+   *   The priority queue of scheduled machines, with access to its heap so that
+   *   it can be saved and restored in the same order.
+   */
+  struct ScheduleQueue
+      : public std::priority_queue<ScheduledMachine,
+                                   std::vector<ScheduledMachine>,
+                                   ScheduledMachineCompare> {
+    std::vector<ScheduledMachine> &container() { return this->c; }
+    const std::vector<ScheduledMachine> &container() const { return this->c; }
+  };
+
+  /**
+   * `FactoryEvent`
+   *
+   *   The machine events handled by the factory.
+   */
+  enum class FactoryEvent : char {
+    ConsumerIsIdleChanged,
+    ProducerIsIdleChanged,
+    HasTargetChanged
+  };
+
+  /**
+   * `QueuedEvent`
+   *
+   *   A machine event waiting to be handled.
+   */
+  struct QueuedEvent {
+    FactoryEvent event;
+    Machine *source;
+  };
+
+  /**
+   * `DrawnMachine`
+   *
+   *   Where and with which frames a machine was last drawn.
+   */
+  struct DrawnMachine {
+    SDL_Rect region;
+    Uint64 key;
+  };
+
   /**
    * `spritesheet`
    *
@@ -44,6 +123,54 @@ class Factory {
    */
   SDL_Point factorySize;
 
+  /**
+   * `blocked`
+   *
+   *   Nonzero for each tile that robots cannot enter, in row-major order.
+   */
+  std::vector<char> blocked;
+
+  /**
+   * `components`
+   *
+   *   The connected components of the walkable tiles, kept up to date with
+   *   the blocked tiles.
+   */
+  ComponentGrid components;
+
+  /**
+   * `walkableGrid`
+   *
+   *   The view of the blocked tiles and their components used by path
+   *   searches.
+   */
+  WalkableGrid walkableGrid;
+
+  /**
+   * `clock`
+   *
+   *   The number of ticks the factory has been updated.
+   */
+  unsigned int clock;
+
+  /**
+   * `elapsed`
+   *
+   *   The number of ticks the factory has been updated, without wraparound.
+   */
+  unsigned long long elapsed;
+
+  /**
+   * `schedule`
+   *
+   *   Busy structure machines ordered by when they will become idle.
+   *
+   * @description
+   *   Structure machines only change state when they finish work, so they are
+   *   updated when they come due instead of at every update.
+   */
+  ScheduleQueue schedule;
+
   /**
    * `tile`
    *
@@ -51,6 +178,13 @@ class Factory {
    */
   Sprite tile;
 
+  /**
+   * `machines`
+   *
+   *   Every machine of the factory, indexed by machine id.
+   */
+  std::vector<Machine *> machines;
+
   /**
    * `consumers`
    *
@@ -65,6 +199,13 @@ class Factory {
    */
   std::list<StructureMachine *> candidateConsumers;
 
+  /**
+   * `candidateConsumerGrid`
+   *
+   *   Spatial index of the candidate target consumer machines.
+   */
+  MachineGrid candidateConsumerGrid;
+
   /**
    * `producers`
    *
@@ -79,6 +220,13 @@ class Factory {
    */
   std::list<StructureMachine *> candidateProducers;
 
+  /**
+   * `candidateProducerGrid`
+   *
+   *   Spatial index of the candidate target producer machines.
+   */
+  MachineGrid candidateProducerGrid;
+
   /**
    * `robots`
    *
@@ -86,6 +234,142 @@ class Factory {
    */
   std::vector<RobotMachine *> robots;
 
+  /**
+   * `threadPool`
+   *
+   *   The threads that advance the robots.
+   */
+  ThreadPool *threadPool;
+
+  /**
+   * `isBatchedAssignment`
+   *
+   *   True if targets are assigned to waiting robots jointly once per update;
+   *   otherwise, each robot picks its own target.
+   */
+  bool isBatchedAssignment;
+
+  /**
+   * `waitingEmptyRobots`
+   *
+   *   Emptyhanded robots waiting to be assigned a producer.
+   */
+  std::vector<RobotMachine *> waitingEmptyRobots;
+
+  /**
+   * `waitingFullRobots`
+   *
+   *   Loaded robots waiting to be assigned a consumer.
+   */
+  std::vector<RobotMachine *> waitingFullRobots;
+
+  /**
+   * `isProducerAssignmentDirty`
+   *
+   *   True if the producer assignment needs to be solved again.
+   */
+  bool isProducerAssignmentDirty;
+
+  /**
+   * `isConsumerAssignmentDirty`
+   *
+   *   True if the consumer assignment needs to be solved again.
+   */
+  bool isConsumerAssignmentDirty;
+
+  /**
+   * `isPipelinedPlanning`
+   *
+   *   True if robots plan their next leg while they travel to and work at
+   *   their current target; otherwise, false.
+   */
+  bool isPipelinedPlanning;
+
+  /**
+   * `anytimeBudget`
+   *
+   *   The number of search iterations after which robots walk a provisional
+   *   path, or 0 if they wait for their target.
+   */
+  unsigned int anytimeBudget;
+
+  /**
+   * `isDeferringEvents`
+   *
+   *   True if machine events are queued and handled once per update;
+   *   otherwise, they are handled as they are emitted.
+   */
+  bool isDeferringEvents;
+
+  /**
+   * `isHandlingEvent`
+   *
+   *   True while a machine event is being handled, so that events handled
+   *   within it are not timed twice.
+   */
+  bool isHandlingEvent;
+
+  /**
+   * `queuedEvents`
+   *
+   *   The machine events waiting to be handled, in the order they were
+   *   emitted.
+   */
+  std::vector<QueuedEvent> queuedEvents;
+
+  /**
+   * `isEventQueued`
+   *
+   *   Nonzero for each machine, by id, with an event in the queue.
+   */
+  std::vector<char> isEventQueued;
+
+  /**
+   * `assignmentSolver`
+   *
+   *   Solves the joint assignment of waiting robots to candidate targets.
+   */
+  AssignmentSolver assignmentSolver;
+
+  /**
+   * `pathService`
+   *
+   *   Finds the path costs of the assignment cost matrix, one search per
+   *   candidate, and then the paths of the assigned pairs. Only used with
+   *   batched assignment; see `PathService`.
+   */
+  PathService pathService;
+
+  /**
+   * `candidateCount`
+   *
+   *   The number of candidates nearest to a robot that it picks its target
+   *   from, or 0 to pick from all of them.
+   */
+  std::size_t candidateCount;
+
+  /**
+   * `nearestCandidates`
+   *
+   *   The result of the last nearest candidates query.
+   */
+  std::vector<Machine *> nearestCandidates;
+
+  /**
+   * `drawnMachines`
+   *
+   *   How each machine, by id, was last drawn in a partial redraw.
+   */
+  std::vector<DrawnMachine> drawnMachines;
+
+  /**
+   * `isDrawValid`
+   *
+   *   True if only the changed regions need to be redrawn; otherwise, the
+   *   whole viewport does.
+   */
+  bool isDrawValid;
+
 public:
   /**
    * `Factory`
@@ -133,19 +417,94 @@ public:
    */
   void Draw(SDL_Renderer *sdlRenderer);
 
+  /**
+   * `Draw`
+   *
+   *   Draws the tiles and machines of the factory that intersect the given
+   *   region of the renderer.
+   */
+  void Draw(SDL_Renderer *sdlRenderer, const SDL_Rect &region);
+
+  /**
+   * `Capture`
+   *
+   *   Replaces the given render state with the tiles and machines of the
+   *   factory that intersect the given region, as they would be drawn now.
+   */
+  void Capture(RenderState &state, const SDL_Rect &region);
+
+  /**
+   * `FindDirtyRegions`
+   *
+   *   Gets the regions of the viewport that have changed since the last call.
+   *
+   * @description
+   *   A machine is dirty when it has moved or would be drawn with different
+   *   frames; both its old and new draw regions are returned. The whole
+   *   viewport is returned after `InvalidateDraw`, and a single bounding
+   *   region when there are many small ones.
+   */
+  void FindDirtyRegions(const SDL_Rect &viewport,
+                        std::vector<SDL_Rect> &regions);
+
+  /**
+   * `InvalidateDraw`
+   *
+   *   Makes the next call to `FindDirtyRegions` return the whole viewport.
+   */
+  void InvalidateDraw() { isDrawValid = false; }
+
+  /**
+   * `Load`
+   *
+   *   Adds the blocked tiles, stations and robots of a layout to the factory.
+   *
+   * @description
+   *   The machine collections are reserved up front so that loading a large
+   *   layout does not reallocate them for each machine. Layout coordinates
+   *   outside of the factory are ignored.
+   */
+  void Load(const FactoryLayout &layout);
+
+  /**
+   * `Save`
+   *
+   *   Writes the simulation state of the factory to a snapshot.
+   *
+   * @description
+   *   The snapshot holds everything that changes while the factory runs: the
+   *   clock, the blocked tiles, the schedule, the candidate lists, and the
+   *   state of every machine including searches in progress. The machines
+   *   themselves are not saved, so a snapshot can only be restored into a
+   *   factory built from the same layout.
+   */
+  void Save(Snapshot &snapshot) const;
+
+  /**
+   * `Restore`
+   *
+   *   Reads the simulation state of the factory from a snapshot written by
+   *   `Save`.
+   *
+   * @returns
+   *   True if the snapshot was restored; otherwise, false, in which case the
+   *   state of the factory is undefined.
+   */
+  bool Restore(Snapshot &snapshot);
+
   /**
    * `AddConsumerMachine`
    *
    *   Adds a consumer machine to the factory at the given factory coordinate.
    */
-  void AddConsumerMachine(int x, int y);
+  void AddConsumerMachine(int x, int y, unsigned int busyDelay = 5000);
 
   /**
    * `AddProducerMachine`
    *
    *   Adds a producer machine to the factory at the given factory coordinate.
    */
-  void AddProducerMachine(int x, int y);
+  void AddProducerMachine(int x, int y, unsigned int busyDelay = 5000);
 
   /**
    * `AddRobotMachine`
@@ -154,6 +513,129 @@ public:
    */
   void AddRobotMachine(int x, int y);
 
+  /**
+   * `SetBatchedAssignment`
+   *
+   *   Enables or disables batched target assignment.
+   *
+   * @description
+   *   When enabled, robots looking for a target are gathered and assigned
+   *   targets jointly once per update. The assignment minimizes the total path
+   *   length of all waiting robots instead of letting each robot greedily pick
+   *   the nearest target and forcing the others to pick again.
+   */
+  void SetBatchedAssignment(bool value);
+
+  /**
+   * `SetPipelinedPlanning`
+   *
+   *   Enables or disables planning the next leg of a robot as soon as its
+   *   current target is claimed. See `RobotMachine::PlanNextLeg`.
+   *
+   * @description
+   *   The planned target stays a candidate for the other robots until the
+   *   robot is done with its current target and claims it. A robot whose
+   *   planned target is claimed first plans again.
+   *
+   *   Only robots picking their own targets plan ahead; the batched assignment
+   *   already plans for all waiting robots at once.
+   */
+  void SetPipelinedPlanning(bool value);
+
+  /**
+   * `SetAnytimeBudget`
+   *
+   *   Sets the number of search iterations after which a robot picking its
+   *   own target starts to walk a provisional path, or 0 to make it wait for
+   *   the target.
+   *
+   * @description
+   *   The provisional path is refined as the search goes on, and the target is
+   *   only claimed once the search is complete. Robots given their targets by
+   *   the batched assignment do not search and are not affected.
+   */
+  void SetAnytimeBudget(unsigned int value);
+
+  /**
+   * `SetDeferredEvents`
+   *
+   *   Enables or disables deferred event handling.
+   *
+   * @description
+   *   When enabled, machine events are queued as they are emitted and handled
+   *   at fixed points of `Update`: after the robots are updated and after
+   *   targets are assigned. A machine is queued at most once however many
+   *   times it emits, and its event is handled against its state at that
+   *   point. Handling an event never recurses into another handler; events
+   *   it causes are appended to the queue.
+   */
+  void SetDeferredEvents(bool value);
+
+  /**
+   * `SetThreadCount`
+   *
+   *   Sets the number of threads that advance the robots, or 0 for one per
+   *   core. The result of an update does not depend on the number of threads.
+   */
+  void SetThreadCount(unsigned int value);
+
+  /**
+   * `SetBlocked`
+   *
+   *   Sets whether or not robots can enter the given tile. Opening a tile
+   *   merges the components around it; blocking one labels the map again.
+   */
+  void SetBlocked(int x, int y, bool value);
+
+  /**
+   * `IsWalkable`
+   *
+   *   True if the point is inside the factory and not blocked; otherwise,
+   *   false.
+   */
+  bool IsWalkable(SDL_Point p) const { return walkableGrid.IsWalkable(p); }
+
+  /**
+   * `GetElapsed`
+   *
+   *   Gets the number of ticks the factory has been updated.
+   */
+  unsigned long long GetElapsed() const { return elapsed; }
+
+  /**
+   * `GetIdleTicks`
+   *
+   *   Gets the number of ticks until the next scheduled machine event, or 0 if
+   *   any robot is working or can reach a candidate target.
+   *
+   * @description
+   *   While no robot can do anything, nothing changes until a busy station
+   *   becomes idle, so the ticks until then can be slept through. Only the
+   *   animations of idle stations are drawn differently in the meantime.
+   */
+  unsigned int GetIdleTicks();
+
+  /**
+   * `GetMetrics`
+   *
+   *   Aggregates the throughput and utilization counters of all machines.
+   */
+  FactoryMetrics GetMetrics();
+
+  /**
+   * `FindNearestCandidates`
+   *
+   *   Finds up to `k` candidate targets nearest to the given factory
+   *   coordinate, ordered by increasing distance. Candidates known to be
+   *   unreachable from the coordinate are left out.
+   *
+   * @param isEmpty
+   *   True to search the candidate producers for an emptyhanded robot; false to
+   *   search the candidate consumers.
+   */
+  void FindNearestCandidates(SDL_Point origin, bool isEmpty, std::size_t k,
+                             std::vector<Machine *> &result) const;
+
   /**
    * `GetDrawWidth`
    *
@@ -171,6 +653,18 @@ public:
    */
   int GetDrawHeight() { return factorySize.y * tile.GetDrawRegion().h / 2; }
 
+  /**
+   * `SetCandidateCount`
+   *
+   *   Sets the number of candidates nearest to a robot, in a straight line,
+   *   that it picks its target from, or 0 to pick from all of them.
+   *
+   * @description
+   *   The nearest candidates are found with the candidate grids, so a robot
+   *   only searches paths to a few targets however many stations are idle.
+   */
+  void SetCandidateCount(std::size_t value) { candidateCount = value; }
+
   /**
    * `SetDrawPoint`
    *
@@ -179,13 +673,135 @@ public:
   void SetDrawPoint(int x, int y) {
     drawPoint.x = x;
     drawPoint.y = y;
+    isDrawValid = false;
   }
 
 private:
+  /**
+   * `DrawBlocked`
+   *
+   *   Draws the blocked tiles of the factory that intersect the given region.
+   */
+  void DrawBlocked(SDL_Renderer *sdlRenderer, const SDL_Rect &region);
+
+  /**
+   * `UpdateStations`
+   *
+   *   Updates the structure machines that have come due.
+   */
+  void UpdateStations();
+
+  /**
+   * `UpdateRobots`
+   *
+   *   Updates the robots and their draw points.
+   *
+   * @description
+   *   Robots are updated in two phases. First every robot is advanced, in
+   *   parallel, which only changes the robot itself. Then the events the
+   *   robots raised, such as claiming a target or finishing a delivery, are
+   *   committed one robot at a time in the order of `robots`, so the outcome is
+   *   the same for any number of threads.
+   */
+  void UpdateRobots();
+
+  /**
+   * `TraceCounters`
+   *
+   *   Records the search and candidate counters in the trace.
+   */
+  void TraceCounters();
+
+  /**
+   * `AddMachine`
+   *
+   *   Gives a new machine its id.
+   */
+  void AddMachine(Machine *machine);
+
+  /**
+   * `Schedule`
+   *
+   *   Schedules a busy structure machine to be updated when it becomes idle.
+   */
+  void Schedule(Machine *machine);
+
+  /**
+   * `AssignTargets`
+   *
+   *   Jointly assigns candidate targets to the waiting robots.
+   *
+   * @param isEmpty
+   *   True to assign producers to emptyhanded robots; false to assign
+   *   consumers to loaded robots.
+   */
+  void AssignTargets(bool isEmpty);
+
+  /**
+   * `FindPickCandidates`
+   *
+   *   Gets the candidates a robot at the given factory coordinate picks its
+   *   target from.
+   *
+   * @param isEmpty
+   *   True for the candidate producers; false for the candidate consumers.
+   */
+  std::list<StructureMachine *> FindPickCandidates(SDL_Point origin,
+                                                   bool isEmpty);
+
+  /**
+   * `QueueEvent`
+   *
+   *   Queues a machine event when events are deferred, or handles it.
+   */
+  void QueueEvent(FactoryEvent event, Machine *source);
+
+  /**
+   * `HandleEvent`
+   *
+   *   Calls the handler of a machine event, timing it in the `Events` zone
+   *   unless it is handled within another event.
+   */
+  void HandleEvent(FactoryEvent event, Machine *source);
+
+  /**
+   * `DispatchEvent`
+   *
+   *   Calls the handler of a machine event.
+   */
+  void DispatchEvent(FactoryEvent event, Machine *source);
+
+  /**
+   * `DrainEvents`
+   *
+   *   Handles the queued events, including any events they cause.
+   */
+  void DrainEvents();
+
+  /**
+   * `AddCandidate`
+   *
+   *   Makes an idle structure machine a candidate target, including for the
+   *   robots already searching.
+   */
+  void AddCandidate(StructureMachine *machine, bool isProducer);
+
+  /**
+   * `RemoveCandidate`
+   *
+   *   Removes a claimed structure machine from the target searches of the
+   *   other robots.
+   */
+  void RemoveCandidate(StructureMachine *machine, bool isProducer);
+
   /**
    * `HasTargetChanged`
    *
    *   Handles the target changed event.
+   *
+   * @description
+   *   Robots advanced in the same update may pick the same target. The first
+   *   to commit keeps it and the others pick again.
    */
   void HasTargetChanged(EventPayload<RobotMachine> &payload);
 
@@ -0,0 +1,227 @@
+/*******************************************************************************
+@file `FactoryLayout.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "FactoryLayout.h"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * `BINARY_MAGIC`
+ *
+ *   The first four bytes of a binary layout file.
+ */
+#define BINARY_MAGIC "FLB1"
+
+/**
+ * `DEFAULT_BUSY_DELAY`
+ *
+ *   The busy delay of a station that does not specify one.
+ */
+#define DEFAULT_BUSY_DELAY 5000
+
+static Uint32 readU32(const char *p) {
+  Uint32 value;
+  std::memcpy(&value, p, sizeof(value));
+  return SDL_SwapLE32(value);
+}
+
+static void writeU32(std::vector<char> &out, Uint32 value) {
+  value = SDL_SwapLE32(value);
+  const char *p = reinterpret_cast<const char *>(&value);
+  out.insert(out.end(), p, p + sizeof(value));
+}
+
+static void writeStations(std::vector<char> &out,
+                          const std::vector<FactoryLayout::Station> &stations) {
+  for (const FactoryLayout::Station &s : stations) {
+    writeU32(out, static_cast<Uint32>(s.point.x));
+    writeU32(out, static_cast<Uint32>(s.point.y));
+    writeU32(out, s.busyDelay);
+  }
+}
+
+static bool readFile(const char *path, std::vector<char> &data) {
+  SDL_RWops *file = SDL_RWFromFile(path, "rb");
+  if (file == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to open layout '%s': %s\n",
+                 path, SDL_GetError());
+    return false;
+  }
+  Sint64 size = SDL_RWsize(file);
+  data.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+  bool ok = data.empty() || SDL_RWread(file, data.data(), data.size(), 1) == 1;
+  SDL_RWclose(file);
+  if (!ok)
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to read layout '%s': %s\n",
+                 path, SDL_GetError());
+  return ok;
+}
+
+void FactoryLayout::Resize(int layoutWidth, int layoutHeight) {
+  width = layoutWidth;
+  height = layoutHeight;
+  blocked.assign(static_cast<std::size_t>(width) * height, 0);
+}
+
+bool FactoryLayout::Load(const char *path) {
+  std::vector<char> data;
+  if (!readFile(path, data))
+    return false;
+  consumers.clear();
+  producers.clear();
+  robots.clear();
+  Resize(0, 0);
+  if (data.size() >= 4 && std::memcmp(data.data(), BINARY_MAGIC, 4) == 0)
+    return ParseBinary(path, data);
+  return ParseText(path, data);
+}
+
+bool FactoryLayout::ParseText(const char *path, std::vector<char> &data) {
+  data.push_back('\0');
+  int lineNumber = 0;
+  for (char *line = data.data(); line != NULL;) {
+    char *end = std::strchr(line, '\n');
+    if (end != NULL)
+      *end = '\0';
+    lineNumber++;
+    char *comment = std::strchr(line, '#');
+    if (comment != NULL)
+      *comment = '\0';
+    if (!ParseLine(line)) {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid layout '%s' line %d\n",
+                   path, lineNumber);
+      return false;
+    }
+    line = end != NULL ? end + 1 : NULL;
+  }
+  if (width <= 0 || height <= 0) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Layout '%s' has no size\n", path);
+    return false;
+  }
+  return true;
+}
+
+bool FactoryLayout::ParseLine(const char *line) {
+  char keyword[16];
+  int a = 0, b = 0, c = 1, d = 1;
+  int n = std::sscanf(line, "%15s %d %d %d %d", keyword, &a, &b, &c, &d);
+  if (n <= 0)
+    return true;
+  if (std::strcmp(keyword, "size") == 0 && n == 3 && a > 0 && b > 0) {
+    Resize(a, b);
+    return true;
+  }
+  if (std::strcmp(keyword, "block") == 0 && (n == 3 || n == 5)) {
+    for (int y = b < 0 ? 0 : b; y < b + d && y < height; y++) {
+      for (int x = a < 0 ? 0 : a; x < a + c && x < width; x++)
+        blocked[static_cast<std::size_t>(y) * width + x] = 1;
+    }
+    return true;
+  }
+  if ((std::strcmp(keyword, "consumer") == 0 ||
+       std::strcmp(keyword, "producer") == 0) &&
+      (n == 3 || n == 4)) {
+    Station s;
+    s.point.x = a;
+    s.point.y = b;
+    s.busyDelay = n == 4 && c > 0 ? c : DEFAULT_BUSY_DELAY;
+    (keyword[0] == 'c' ? consumers : producers).push_back(s);
+    return true;
+  }
+  if (std::strcmp(keyword, "robot") == 0 && n == 3) {
+    SDL_Point p;
+    p.x = a;
+    p.y = b;
+    robots.push_back(p);
+    return true;
+  }
+  return false;
+}
+
+bool FactoryLayout::ParseBinary(const char *path,
+                                const std::vector<char> &data) {
+  const std::size_t headerSize = 4 + 5 * 4;
+  if (data.size() < headerSize) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Truncated layout '%s'\n", path);
+    return false;
+  }
+  const char *p = data.data() + 4;
+  Uint32 w = readU32(p);
+  Uint32 h = readU32(p + 4);
+  Uint32 consumerCount = readU32(p + 8);
+  Uint32 producerCount = readU32(p + 12);
+  Uint32 robotCount = readU32(p + 16);
+  std::size_t tiles = static_cast<std::size_t>(w) * h;
+  std::size_t size = headerSize + (tiles + 7) / 8 +
+                     (static_cast<std::size_t>(consumerCount) + producerCount) *
+                         12 +
+                     static_cast<std::size_t>(robotCount) * 8;
+  if (w == 0 || h == 0 || data.size() < size) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Truncated layout '%s'\n", path);
+    return false;
+  }
+  Resize(w, h);
+  p = data.data() + headerSize;
+  for (std::size_t i = 0; i < tiles; i++)
+    blocked[i] = (p[i >> 3] >> (i & 7)) & 1;
+  p += (tiles + 7) / 8;
+
+  consumers.resize(consumerCount);
+  producers.resize(producerCount);
+  robots.resize(robotCount);
+  for (Station &s : consumers) {
+    s.point.x = static_cast<Sint32>(readU32(p));
+    s.point.y = static_cast<Sint32>(readU32(p + 4));
+    s.busyDelay = readU32(p + 8);
+    p += 12;
+  }
+  for (Station &s : producers) {
+    s.point.x = static_cast<Sint32>(readU32(p));
+    s.point.y = static_cast<Sint32>(readU32(p + 4));
+    s.busyDelay = readU32(p + 8);
+    p += 12;
+  }
+  for (SDL_Point &r : robots) {
+    r.x = static_cast<Sint32>(readU32(p));
+    r.y = static_cast<Sint32>(readU32(p + 4));
+    p += 8;
+  }
+  return true;
+}
+
+bool FactoryLayout::SaveBinary(const char *path) const {
+  std::size_t tiles = static_cast<std::size_t>(width) * height;
+  std::vector<char> out(BINARY_MAGIC, BINARY_MAGIC + 4);
+  out.reserve(4 + 5 * 4 + (tiles + 7) / 8 +
+              (consumers.size() + producers.size()) * 12 + robots.size() * 8);
+  writeU32(out, width);
+  writeU32(out, height);
+  writeU32(out, consumers.size());
+  writeU32(out, producers.size());
+  writeU32(out, robots.size());
+  std::size_t bits = out.size();
+  out.resize(bits + (tiles + 7) / 8, 0);
+  for (std::size_t i = 0; i < tiles; i++)
+    out[bits + (i >> 3)] |= static_cast<char>((blocked[i] ? 1 : 0) << (i & 7));
+  writeStations(out, consumers);
+  writeStations(out, producers);
+  for (const SDL_Point &r : robots) {
+    writeU32(out, static_cast<Uint32>(r.x));
+    writeU32(out, static_cast<Uint32>(r.y));
+  }
+
+  SDL_RWops *file = SDL_RWFromFile(path, "wb");
+  if (file == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to open layout '%s': %s\n",
+                 path, SDL_GetError());
+    return false;
+  }
+  bool ok = SDL_RWwrite(file, out.data(), out.size(), 1) == 1;
+  SDL_RWclose(file);
+  return ok;
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+@file `FactoryLayout.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * `FactoryLayout`
+ *
+ *   Describes the contents of a factory: its size, blocked tiles, stations and
+ *   robot spawn points.
+ *
+ * @description
+ *   Layouts are loaded from either a text file for hand editing or a binary
+ *   file for large maps. The format is detected from the file contents.
+ *
+ *   The text format is line based; `#` starts a comment:
+ *
+ *     size <width> <height>
+ *     block <x> <y> [<width> <height>]
+ *     consumer <x> <y> [<busy delay>]
+ *     producer <x> <y> [<busy delay>]
+ *     robot <x> <y>
+ *
+ *   The binary format is little endian:
+ *
+ *     "FLB1"
+ *     u32 width, height, consumer count, producer count, robot count
+ *     blocked tiles as a row-major bitset of ceil(width * height / 8) bytes
+ *     consumers and producers as { i32 x, i32 y, u32 busy delay }
+ *     robots as { i32 x, i32 y }
+ */
+class FactoryLayout {
+public:
+  /**
+   * `Station`
+   *
+   *   A structure machine in the layout.
+   */
+  struct Station {
+    SDL_Point point;
+    unsigned int busyDelay;
+  };
+
+  /**
+   * `width`, `height`
+   *
+   *   The size of the factory in tiles.
+   */
+  int width;
+  int height;
+
+  /**
+   * `blocked`
+   *
+   *   Nonzero for each tile that robots cannot enter, in row-major order.
+   */
+  std::vector<char> blocked;
+
+  /**
+   * `consumers`, `producers`
+   *
+   *   The stations of the factory.
+   */
+  std::vector<Station> consumers;
+  std::vector<Station> producers;
+
+  /**
+   * `robots`
+   *
+   *   The spawn points of the robots.
+   */
+  std::vector<SDL_Point> robots;
+
+  FactoryLayout() : width(0), height(0) {}
+
+  /**
+   * `Resize`
+   *
+   *   Sets the size of the factory and clears its blocked tiles.
+   */
+  void Resize(int layoutWidth, int layoutHeight);
+
+  /**
+   * `Load`
+   *
+   *   Loads a text or binary layout file.
+   *
+   * @returns
+   *   True if the layout was loaded; otherwise, false.
+   */
+  bool Load(const char *path);
+
+  /**
+   * `SaveBinary`
+   *
+   *   Saves the layout in the binary format.
+   *
+   * @returns
+   *   True if the layout was saved; otherwise, false.
+   */
+  bool SaveBinary(const char *path) const;
+
+private:
+  bool ParseText(const char *path, std::vector<char> &data);
+  bool ParseLine(const char *line);
+  bool ParseBinary(const char *path, const std::vector<char> &data);
+};
@@ -0,0 +1,54 @@
+/*******************************************************************************
+@file `FramePacer.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "FramePacer.h"
+
+/**
+ * `YIELD_TICKS`
+ *
+ *   The number of milliseconds before a frame is due below which the pacer
+ *   yields instead of sleeping.
+ */
+#define YIELD_TICKS 1
+
+FramePacer::FramePacer()
+    : frequency(SDL_GetPerformanceFrequency()), period(0),
+      deadline(SDL_GetPerformanceCounter()) {}
+
+void FramePacer::SetTargetRate(unsigned int fps) {
+  period = fps > 0 ? frequency / fps : 0;
+  deadline = SDL_GetPerformanceCounter();
+}
+
+unsigned int FramePacer::GetPeriodTicks() const {
+  return static_cast<unsigned int>(period * 1000 / frequency);
+}
+
+void FramePacer::Wait() {
+  if (period == 0)
+    return;
+  deadline += period;
+  Uint64 now = SDL_GetPerformanceCounter();
+  if (now >= deadline) {
+    if (now - deadline > period)
+      deadline = now;
+    return;
+  }
+  Uint64 remaining = (deadline - now) * 1000 / frequency;
+  if (remaining > YIELD_TICKS)
+    SDL_Delay(static_cast<Uint32>(remaining - YIELD_TICKS));
+  // A zero delay gives up the rest of the time slice, so the core is free for
+  // other threads while the frame is still due.
+  while (SDL_GetPerformanceCounter() < deadline)
+    SDL_Delay(0);
+}
+
+void FramePacer::WaitIdle(unsigned int ticks) {
+  SDL_WaitEventTimeout(NULL, static_cast<int>(ticks));
+  deadline = SDL_GetPerformanceCounter();
+}
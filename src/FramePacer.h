@@ -0,0 +1,85 @@
+/*******************************************************************************
+@file `FramePacer.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/**
+ * `FramePacer`
+ *
+ *   Limits the main loop to a target frame rate.
+ *
+ * @description
+ *   Frames are due at a fixed period measured with the performance counter.
+ *   The pacer sleeps for whole milliseconds until the frame is close and
+ *   yields its time slice until the frame is due, so frames are neither late
+ *   by the granularity of `SDL_Delay` nor burn a core while waiting. A frame
+ *   that is late by more than a period starts the schedule over instead of
+ *   rushing to catch up.
+ */
+class FramePacer {
+
+  /**
+   * `frequency`
+   *
+   *   The number of performance counter ticks per second.
+   */
+  Uint64 frequency;
+
+  /**
+   * `period`
+   *
+   *   The number of performance counter ticks per frame, or 0 for no limit.
+   */
+  Uint64 period;
+
+  /**
+   * `deadline`
+   *
+   *   The performance counter value at which the next frame is due.
+   */
+  Uint64 deadline;
+
+public:
+  /**
+   * `FramePacer`
+   *
+   *   Constructor. Frames are not limited until a target rate is set.
+   */
+  FramePacer();
+
+  /**
+   * `SetTargetRate`
+   *
+   *   Sets the target number of frames per second, or 0 for no limit.
+   */
+  void SetTargetRate(unsigned int fps);
+
+  /**
+   * `GetPeriodTicks`
+   *
+   *   Gets the number of milliseconds per frame, or 0 for no limit.
+   */
+  unsigned int GetPeriodTicks() const;
+
+  /**
+   * `Wait`
+   *
+   *   Waits until the next frame is due.
+   */
+  void Wait();
+
+  /**
+   * `WaitIdle`
+   *
+   *   Blocks until an event arrives or the given number of milliseconds has
+   *   passed, whichever is first, and starts the frame schedule over.
+   */
+  void WaitIdle(unsigned int ticks);
+};
@@ -26,6 +26,12 @@
  *   iterative algorithm. This is particularly useful for game objects that need
  *   to process data in an iterative manner, such as calculating the shortest
  *   path.
+ *
+ *   Derived algorithms keep their loop position in a `Step` enumeration rather
+ *   than in stored callbacks. Each loop header becomes a private member
+ *   function, and `Next` is a single `switch` over the current step. Resuming
+ *   an iteration is therefore a direct branch; nothing is type-erased and no
+ *   closure is rebuilt when the algorithm moves from one loop to another.
  */
 template <class R, class... Args> class IterativeAlgorithm {
 
@@ -7,12 +7,14 @@
 *******************************************************************************/
 
 #include "Machine.h"
+#include "Trace.h"
 
 #define IS_IDLE_CHANGED_EVENT "Machine::IsIdleChanged"
 
 Machine::Machine(AnimatedSprite sprite, SDL_Point factoryPoint,
                  unsigned int busyDelay)
-    : _busyDelay(busyDelay), _busyTick(busyDelay), _factoryPoint(factoryPoint),
+    : _id(-1), _busyDelay(busyDelay), _busyTick(busyDelay), _updateTick(0),
+      _factoryPoint(factoryPoint),
       _sprite(sprite), _isPaused(true) {
   AddEvent(IS_IDLE_CHANGED_EVENT);
   _sprite.Play();
@@ -28,17 +30,61 @@ void Machine::AddIsIdleChangedEventHandler(
 //   RemoveEventHandler(IS_IDLE_CHANGED_EVENT, handler);
 // }
 
+void Machine::Save(Snapshot &snapshot) const {
+  snapshot.Write(_busyDelay);
+  snapshot.Write(_busyTick);
+  snapshot.Write(_updateTick);
+  snapshot.Write(_factoryPoint);
+  snapshot.Write(_isPaused);
+  snapshot.Write(_metrics);
+  snapshot.Write(_sprite.GetStartTick());
+}
+
+void Machine::Restore(Snapshot &snapshot) {
+  snapshot.Read(_busyDelay);
+  snapshot.Read(_busyTick);
+  snapshot.Read(_updateTick);
+  snapshot.Read(_factoryPoint);
+  snapshot.Read(_isPaused);
+  snapshot.Read(_metrics);
+  unsigned int startTick;
+  snapshot.Read(startTick);
+  _sprite.SetStartTick(startTick);
+}
+
 void Machine::Update(unsigned int dt) {
   _busyTick += (_isPaused || IsIdle() ? 0 : dt);
-  _sprite.Update(dt);
   if (!_isPaused && IsIdle()) {
+    _metrics.busyTicks += _busyDelay;
     Pause();
     OnIsIdleChanged();
   }
   OnUpdate(dt);
 }
 
-void Machine::Draw(SDL_Renderer *sdlRenderer) { _sprite.Draw(sdlRenderer); }
+void Machine::UpdateTo(unsigned int tick) {
+  unsigned int dt = tick - _updateTick;
+  _updateTick = tick;
+  Update(dt);
+}
+
+void Machine::SetUpdateTick(unsigned int tick) { _updateTick = tick; }
+
+unsigned int Machine::GetIdleTick() {
+  return _updateTick + (IsIdle() ? 0 : _busyDelay - _busyTick);
+}
+
+void Machine::Draw(SDL_Renderer *sdlRenderer, unsigned int tick) {
+  _sprite.Draw(sdlRenderer, tick);
+}
+
+void Machine::Capture(RenderState &state, unsigned int tick) {
+  _sprite.Capture(state, tick);
+}
+
+Uint64 Machine::GetDrawKey(unsigned int tick) {
+  return _sprite.GetFrameKey(tick);
+}
 
 bool Machine::IsIdle() { return _busyTick >= _busyDelay; }
 
@@ -47,8 +93,10 @@ void Machine::Start() { _isPaused = false; }
 void Machine::Pause() { _isPaused = true; }
 
 void Machine::Restart() {
+  _metrics.jobs++;
   Reset();
   Start();
+  _sprite.SetStartTick(_updateTick);
   OnIsIdleChanged();
 }
 
@@ -58,6 +106,12 @@ unsigned int Machine::GetProgress() {
   return (_busyTick > _busyDelay ? 100 : 100 * _busyTick / _busyDelay);
 }
 
+unsigned int Machine::GetProgress(unsigned int tick) {
+  unsigned int busyTick =
+      _busyTick + (_isPaused || IsIdle() ? 0 : tick - _updateTick);
+  return (busyTick > _busyDelay ? 100 : 100 * busyTick / _busyDelay);
+}
+
 SDL_Point &Machine::GetFactoryPoint() { return _factoryPoint; }
 
 void Machine::SetFactoryPoint(SDL_Point value) { _factoryPoint = value; }
@@ -71,9 +125,13 @@ void Machine::SetDrawPoint(const int x, const int y) {
   _sprite.SetDrawRegionPoint(x, y);
 }
 
+MachineMetrics &Machine::GetMetrics() { return _metrics; }
+
 AnimatedSprite &Machine::GetMachineSprite() { return _sprite; }
 
 void Machine::OnIsIdleChanged() {
+  if (Trace::IsEnabled())
+    Trace::Instant(IS_IDLE_CHANGED_EVENT, this, IsIdle());
   EventPayload<Machine> payload(this);
   EmitEvent(IS_IDLE_CHANGED_EVENT, payload);
 }
\ No newline at end of file
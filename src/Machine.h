@@ -10,6 +10,9 @@
 
 #include "AnimatedSprite.h"
 #include "Events.h"
+#include "Metrics.h"
+#include "RenderState.h"
+#include "Snapshot.h"
 #include <SDL2/SDL.h>
 #include <functional>
 #include <vector>
@@ -21,6 +24,13 @@
  */
 class Machine : private EventEmitter<Machine> {
 
+  /**
+   * `_id`
+   *
+   *   The id of the machine in its factory, or -1 if it has none.
+   */
+  int _id;
+
   /**
    * `_busyDelay`
    *
@@ -35,6 +45,13 @@ class Machine : private EventEmitter<Machine> {
    */
   unsigned int _busyTick;
 
+  /**
+   * `_updateTick`
+   *
+   *   The factory tick at which the machine was last updated.
+   */
+  unsigned int _updateTick;
+
   /**
    * `_factoryPoint`
    *
@@ -56,6 +73,13 @@ class Machine : private EventEmitter<Machine> {
    */
   bool _isPaused;
 
+  /**
+   * `_metrics`
+   *
+   *   The counters accumulated by the machine.
+   */
+  MachineMetrics _metrics;
+
 public:
   /**
    * `Machine`
@@ -100,6 +124,38 @@ public:
   // void RemoveIsIdleChangedEventHandler(
   //     std::function<void(EventPayload<Machine> &)> handler);
 
+  /**
+   * `GetId`
+   *
+   *   Gets the id of the machine in its factory.
+   */
+  int GetId() const { return _id; }
+
+  /**
+   * `SetId`
+   *
+   *   Sets the id of the machine in its factory.
+   */
+  void SetId(int value) { _id = value; }
+
+  /**
+   * `Save`
+   *
+   *   Writes the simulation state of the machine to a snapshot.
+   */
+  virtual void Save(Snapshot &snapshot) const;
+
+  /**
+   * `Restore`
+   *
+   *   Reads the simulation state of the machine from a snapshot.
+   *
+   * @description
+   *   No events are emitted; the factory restores its own state from the same
+   *   snapshot.
+   */
+  virtual void Restore(Snapshot &snapshot);
+
   /**
    * `Update`
    *
@@ -107,12 +163,58 @@ public:
    */
   void Update(unsigned int dt);
 
+  /**
+   * `UpdateTo`
+   *
+   *   Updates the machine by the ticks elapsed between its last update and the
+   *   given factory tick.
+   */
+  void UpdateTo(unsigned int tick);
+
+  /**
+   * `SetUpdateTick`
+   *
+   *   Sets the factory tick of the last update without updating the machine.
+   */
+  void SetUpdateTick(unsigned int tick);
+
+  /**
+   * `GetUpdateTick`
+   *
+   *   Gets the factory tick of the last update.
+   */
+  unsigned int GetUpdateTick() const { return _updateTick; }
+
+  /**
+   * `GetIdleTick`
+   *
+   *   Gets the factory tick at which the busy machine will become idle.
+   */
+  unsigned int GetIdleTick();
+
   /**
    * `Draw`
    *
-   *   Draws the machine on the given renderer.
+   *   Draws the machine on the given renderer as it is at the given factory
+   *   tick.
    */
-  virtual void Draw(SDL_Renderer *sdlRenderer);
+  virtual void Draw(SDL_Renderer *sdlRenderer, unsigned int tick);
+
+  /**
+   * `Capture`
+   *
+   *   Adds the machine to the given render state as it is drawn at the given
+   *   factory tick.
+   */
+  virtual void Capture(RenderState &state, unsigned int tick);
+
+  /**
+   * `GetDrawKey`
+   *
+   *   Gets a value that changes whenever the machine would be drawn with
+   *   different frames at the given factory tick.
+   */
+  virtual Uint64 GetDrawKey(unsigned int tick);
 
   /**
    * `IsIdle`
@@ -138,7 +240,8 @@ public:
   /**
    * `Restart`
    *
-   *   Signals the machine to restart working.
+   *   Signals the machine to restart working at the tick of its last update.
+   *   Its animation starts over from that tick.
    */
   void Restart();
 
@@ -156,6 +259,14 @@ public:
    */
   unsigned int GetProgress();
 
+  /**
+   * `GetProgress`
+   *
+   *   Gets the work progress of the machine at the given factory tick, which
+   *   may be later than its last update.
+   */
+  unsigned int GetProgress(unsigned int tick);
+
   /**
    * `GetFactoryPoint`
    *
@@ -184,6 +295,13 @@ public:
    */
   virtual void SetDrawPoint(const int x, const int y);
 
+  /**
+   * `GetMetrics`
+   *
+   *   Gets the counters accumulated by the machine.
+   */
+  MachineMetrics &GetMetrics();
+
   /**
    * `GetMachineSprite`
    *
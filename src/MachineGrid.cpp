@@ -0,0 +1,117 @@
+/*******************************************************************************
+@file `MachineGrid.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "MachineGrid.h"
+#include <algorithm>
+
+static int clamp(int value, int lo, int hi) {
+  return value < lo ? lo : (value > hi ? hi : value);
+}
+
+MachineGrid::MachineGrid(int width, int height, int gridCellSize)
+    : cellSize(gridCellSize),
+      columns((width + gridCellSize - 1) / gridCellSize),
+      rows((height + gridCellSize - 1) / gridCellSize), count(0),
+      cells(columns * rows) {}
+
+std::vector<MachineGrid::Entry> &MachineGrid::GetCell(SDL_Point p) {
+  int cx = clamp(p.x / cellSize, 0, columns - 1);
+  int cy = clamp(p.y / cellSize, 0, rows - 1);
+  return cells[cy * columns + cx];
+}
+
+void MachineGrid::Insert(Machine *machine) {
+  Entry entry;
+  entry.point = machine->GetFactoryPoint();
+  entry.machine = machine;
+  GetCell(entry.point).push_back(entry);
+  count++;
+}
+
+bool MachineGrid::Remove(Machine *machine) {
+  std::vector<Entry> &cell = GetCell(machine->GetFactoryPoint());
+  for (std::size_t i = 0; i < cell.size(); i++) {
+    if (cell[i].machine == machine) {
+      cell[i] = cell.back();
+      cell.pop_back();
+      count--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void MachineGrid::Nearest(
+    SDL_Point origin, std::size_t k, std::vector<Machine *> &result,
+    const std::function<bool(SDL_Point)> &isIncluded) const {
+  std::vector<Neighbor> heap;
+  heap.reserve(k);
+  for (int ring = 0; ScanRing(origin, ring, k, isIncluded, heap); ring++)
+    ;
+  std::sort_heap(heap.begin(), heap.end());
+  result.clear();
+  for (const Neighbor &n : heap)
+    result.push_back(n.machine);
+}
+
+bool MachineGrid::ScanRing(SDL_Point origin, int ring, std::size_t k,
+                           const std::function<bool(SDL_Point)> &isIncluded,
+                           std::vector<Neighbor> &heap) const {
+  if (k == 0 || columns == 0 || rows == 0)
+    return false;
+  int cx = clamp(origin.x / cellSize, 0, columns - 1);
+  int cy = clamp(origin.y / cellSize, 0, rows - 1);
+
+  // Every tile in this ring is at least this far from the origin along one
+  // axis, so nothing here can beat a full heap whose worst is closer.
+  int bound = ring > 0 ? (ring - 1) * cellSize + 1 : 0;
+  if (heap.size() == k && bound * bound > heap.front().dist)
+    return false;
+
+  int x0 = cx - ring, x1 = cx + ring;
+  int y0 = cy - ring, y1 = cy + ring;
+  if (x0 < 0 && y0 < 0 && x1 >= columns && y1 >= rows)
+    return false;
+  if (ring == 0)
+    ScanCell(cx, cy, origin, k, isIncluded, heap);
+  else {
+    for (int x = std::max(x0, 0); x <= std::min(x1, columns - 1); x++) {
+      ScanCell(x, y0, origin, k, isIncluded, heap);
+      ScanCell(x, y1, origin, k, isIncluded, heap);
+    }
+    for (int y = std::max(y0 + 1, 0); y <= std::min(y1 - 1, rows - 1); y++) {
+      ScanCell(x0, y, origin, k, isIncluded, heap);
+      ScanCell(x1, y, origin, k, isIncluded, heap);
+    }
+  }
+  return true;
+}
+
+void MachineGrid::ScanCell(int cx, int cy, SDL_Point origin, std::size_t k,
+                           const std::function<bool(SDL_Point)> &isIncluded,
+                           std::vector<Neighbor> &heap) const {
+  if (cx < 0 || cx >= columns || cy < 0 || cy >= rows)
+    return;
+  for (const Entry &entry : cells[cy * columns + cx]) {
+    if (isIncluded && !isIncluded(entry.point))
+      continue;
+    int x = origin.x - entry.point.x;
+    int y = origin.y - entry.point.y;
+    Neighbor n;
+    n.dist = x * x + y * y;
+    n.machine = entry.machine;
+    if (heap.size() < k) {
+      heap.push_back(n);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (n.dist < heap.front().dist) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = n;
+      std::push_heap(heap.begin(), heap.end());
+    }
+  }
+}
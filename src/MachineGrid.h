@@ -0,0 +1,162 @@
+/*******************************************************************************
+@file `MachineGrid.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include "Machine.h"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * `MachineGrid`
+ *
+ *   A spatial index of machines bucketed by factory coordinates.
+ *
+ * @description
+ *   The factory is divided into square cells of `cellSize` tiles. Each cell
+ *   keeps the machines inside it together with their factory coordinates, so
+ *   queries never need to call back into the machines.
+ *
+ *   Nearest-machine queries visit cells in rings of increasing Chebyshev
+ *   distance from the cell containing the origin. A query stops as soon as it
+ *   holds `k` machines and the next ring cannot contain anything closer.
+ */
+class MachineGrid {
+public:
+  /**
+   * `Neighbor`
+   *
+   *   A machine found by a query along with its squared distance to the
+   *   origin of the query.
+   */
+  struct Neighbor {
+    int dist;
+    Machine *machine;
+    bool operator<(const Neighbor &rhs) const { return dist < rhs.dist; }
+  };
+
+private:
+  /**
+   * `Entry`
+   *
+   *   A machine stored in a cell along with its factory coordinates.
+   */
+  struct Entry {
+    SDL_Point point;
+    Machine *machine;
+  };
+
+  /**
+   * `cellSize`
+   *
+   *   The height and width of each cell in factory tiles.
+   */
+  int cellSize;
+
+  /**
+   * `columns`
+   *
+   *   The number of cell columns.
+   */
+  int columns;
+
+  /**
+   * `rows`
+   *
+   *   The number of cell rows.
+   */
+  int rows;
+
+  /**
+   * `count`
+   *
+   *   The number of machines in the grid.
+   */
+  std::size_t count;
+
+  /**
+   * `cells`
+   *
+   *   The machine buckets in row-major order.
+   */
+  std::vector<std::vector<Entry>> cells;
+
+public:
+  /**
+   * `MachineGrid`
+   *
+   *   Constructor.
+   *
+   * @param width
+   *   The tile width of the factory.
+   *
+   * @param height
+   *   The tile height of the factory.
+   *
+   * @param gridCellSize
+   *   The height and width of each cell in factory tiles.
+   */
+  MachineGrid(int width, int height, int gridCellSize);
+
+  /**
+   * `Insert`
+   *
+   *   Adds a machine to the grid at its current factory coordinates.
+   */
+  void Insert(Machine *machine);
+
+  /**
+   * `Remove`
+   *
+   *   Removes a machine from the grid if it is present.
+   *
+   * @returns
+   *   True if the machine was in the grid; otherwise, false.
+   */
+  bool Remove(Machine *machine);
+
+  /**
+   * `Size`
+   *
+   *   Gets the number of machines in the grid.
+   */
+  std::size_t Size() const { return count; }
+
+  /**
+   * `Nearest`
+   *
+   *   Finds up to `k` machines nearest to the given origin, ordered by
+   *   increasing distance. If `isIncluded` is given, only the machines at
+   *   factory coordinates it accepts are found, so that rejected machines do
+   *   not take the place of farther ones.
+   */
+  void Nearest(SDL_Point origin, std::size_t k, std::vector<Machine *> &result,
+               const std::function<bool(SDL_Point)> &isIncluded =
+                   std::function<bool(SDL_Point)>()) const;
+
+private:
+  /**
+   * `ScanRing`
+   *
+   *   Visits the cells of a single ring around the origin, keeping the `k`
+   *   nearest machines found so far in the max-heap `heap`.
+   *
+   * @returns
+   *   True if a further ring could still improve the result; otherwise, false.
+   */
+  bool ScanRing(SDL_Point origin, int ring, std::size_t k,
+                const std::function<bool(SDL_Point)> &isIncluded,
+                std::vector<Neighbor> &heap) const;
+
+  std::vector<Entry> &GetCell(SDL_Point p);
+  void ScanCell(int cx, int cy, SDL_Point origin, std::size_t k,
+                const std::function<bool(SDL_Point)> &isIncluded,
+                std::vector<Neighbor> &heap) const;
+};
@@ -0,0 +1,92 @@
+/*******************************************************************************
+@file `Metrics.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "Metrics.h"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * `TICKS_PER_HOUR`
+ *
+ *   The number of ticks in an hour of simulated time.
+ */
+#define TICKS_PER_HOUR 3600000.0
+
+static double ratio(unsigned long long n, unsigned long long d) {
+  return d == 0 ? 0.0 : static_cast<double>(n) / static_cast<double>(d);
+}
+
+static bool endsWith(const char *value, const char *suffix) {
+  std::size_t n = std::strlen(value);
+  std::size_t m = std::strlen(suffix);
+  return n >= m && std::strcmp(value + n - m, suffix) == 0;
+}
+
+double FactoryMetrics::GetDeliveriesPerHour() const {
+  return TICKS_PER_HOUR * ratio(consumerTotals.jobs, ticks);
+}
+
+double FactoryMetrics::GetConsumerUtilization() const {
+  return ratio(consumerTotals.busyTicks, ticks * consumers);
+}
+
+double FactoryMetrics::GetProducerUtilization() const {
+  return ratio(producerTotals.busyTicks, ticks * producers);
+}
+
+double FactoryMetrics::GetRobotIdleFraction() const {
+  return ratio(robotTotals.idleTicks, ticks * robots);
+}
+
+bool MetricsWriter::Open(const char *path) {
+  Close();
+  isJson = endsWith(path, ".json") || endsWith(path, ".jsonl");
+  file = SDL_RWFromFile(path, "wb");
+  if (file == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to open metrics '%s': %s\n",
+                 path, SDL_GetError());
+    return false;
+  }
+  if (!isJson) {
+    const char *header = "ticks,consumers,producers,robots,delivered,"
+                         "picked_up,robot_jobs,robot_steps,robot_idle_ticks,"
+                         "deliveries_per_hour,consumer_utilization,"
+                         "producer_utilization,robot_idle_fraction\n";
+    SDL_RWwrite(file, header, 1, std::strlen(header));
+  }
+  return true;
+}
+
+void MetricsWriter::Close() {
+  if (file != NULL) {
+    SDL_RWclose(file);
+    file = NULL;
+  }
+}
+
+void MetricsWriter::Write(const FactoryMetrics &m) {
+  if (file == NULL)
+    return;
+  const char *format =
+      isJson ? "{\"ticks\":%llu,\"consumers\":%u,\"producers\":%u,"
+               "\"robots\":%u,\"delivered\":%llu,\"picked_up\":%llu,"
+               "\"robot_jobs\":%llu,\"robot_steps\":%llu,"
+               "\"robot_idle_ticks\":%llu,\"deliveries_per_hour\":%.3f,"
+               "\"consumer_utilization\":%.4f,"
+               "\"producer_utilization\":%.4f,"
+               "\"robot_idle_fraction\":%.4f}\n"
+             : "%llu,%u,%u,%u,%llu,%llu,%llu,%llu,%llu,%.3f,%.4f,%.4f,%.4f\n";
+  char line[512];
+  int n = std::snprintf(
+      line, sizeof(line), format, m.ticks, m.consumers, m.producers, m.robots,
+      m.consumerTotals.jobs, m.producerTotals.jobs, m.robotTotals.jobs,
+      m.robotTotals.steps, m.robotTotals.idleTicks, m.GetDeliveriesPerHour(),
+      m.GetConsumerUtilization(), m.GetProducerUtilization(),
+      m.GetRobotIdleFraction());
+  SDL_RWwrite(file, line, 1, n);
+}
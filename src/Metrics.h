@@ -0,0 +1,154 @@
+/*******************************************************************************
+@file `Metrics.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/**
+ * `MachineMetrics`
+ *
+ *   Counters accumulated by a single machine.
+ */
+struct MachineMetrics {
+
+  /**
+   * `jobs`
+   *
+   *   The number of times the machine was restarted. For a consumer this is
+   *   the number of payloads delivered to it; for a producer, the number of
+   *   payloads picked up from it; for a robot, the number of loads and unloads.
+   */
+  unsigned long long jobs;
+
+  /**
+   * `busyTicks`
+   *
+   *   The number of ticks spent on completed jobs.
+   */
+  unsigned long long busyTicks;
+
+  /**
+   * `idleTicks`
+   *
+   *   The number of ticks a robot spent without a target or a path.
+   */
+  unsigned long long idleTicks;
+
+  /**
+   * `steps`
+   *
+   *   The number of tiles a robot has travelled.
+   */
+  unsigned long long steps;
+
+  MachineMetrics() : jobs(0), busyTicks(0), idleTicks(0), steps(0) {}
+};
+
+/**
+ * `FactoryMetrics`
+ *
+ *   Throughput and utilization of a factory, aggregated over its machines.
+ */
+struct FactoryMetrics {
+  unsigned long long ticks;
+  unsigned int consumers;
+  unsigned int producers;
+  unsigned int robots;
+  MachineMetrics consumerTotals;
+  MachineMetrics producerTotals;
+  MachineMetrics robotTotals;
+
+  FactoryMetrics() : ticks(0), consumers(0), producers(0), robots(0) {}
+
+  /**
+   * `GetDeliveriesPerHour`
+   *
+   *   Gets the number of payloads delivered to consumers per simulated hour.
+   */
+  double GetDeliveriesPerHour() const;
+
+  /**
+   * `GetConsumerUtilization`
+   *
+   *   Gets the fraction of time consumers spent working.
+   */
+  double GetConsumerUtilization() const;
+
+  /**
+   * `GetProducerUtilization`
+   *
+   *   Gets the fraction of time producers spent working.
+   */
+  double GetProducerUtilization() const;
+
+  /**
+   * `GetRobotIdleFraction`
+   *
+   *   Gets the fraction of time robots spent without a target.
+   */
+  double GetRobotIdleFraction() const;
+};
+
+/**
+ * `MetricsWriter`
+ *
+ *   Appends factory metrics to a CSV file, or to a JSON Lines file if the path
+ *   ends in `.json` or `.jsonl`.
+ */
+class MetricsWriter {
+
+  /**
+   * `file`
+   *
+   *   The metrics file being written; `NULL` if not open.
+   */
+  SDL_RWops *file;
+
+  /**
+   * `isJson`
+   *
+   *   True if the metrics are written as JSON Lines; otherwise, CSV.
+   */
+  bool isJson;
+
+public:
+  MetricsWriter() : file(NULL), isJson(false) {}
+  ~MetricsWriter() { Close(); }
+
+  /**
+   * `Open`
+   *
+   *   Opens the metrics file, writing the CSV header if needed.
+   *
+   * @returns
+   *   True if the file was opened; otherwise, false.
+   */
+  bool Open(const char *path);
+
+  /**
+   * `Close`
+   *
+   *   Closes the metrics file.
+   */
+  void Close();
+
+  /**
+   * `IsOpen`
+   *
+   *   True if the metrics file is open; otherwise, false.
+   */
+  bool IsOpen() const { return file != NULL; }
+
+  /**
+   * `Write`
+   *
+   *   Appends a record of the given metrics.
+   */
+  void Write(const FactoryMetrics &metrics);
+};
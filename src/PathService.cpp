@@ -0,0 +1,215 @@
+/*******************************************************************************
+@file `PathService.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "PathService.h"
+#include <algorithm>
+#include <climits>
+
+/**
+ * `MAX_TARGETED_STARTS`
+ *
+ *   The number of starts left above which a search grows evenly around the
+ *   goal, since most of the map is searched anyway and the estimate to the
+ *   nearest start would cost more than it saves.
+ */
+#define MAX_TARGETED_STARTS 8u
+
+PathService::PathService(const WalkableGrid &walkableGrid)
+    : grid(walkableGrid), stamp(0) {}
+
+void PathService::Request(SDL_Point start, StructureMachine *goal,
+                          std::function<void(TargetPath &)> callback) {
+  Query query;
+  query.start = start;
+  query.goal = goal;
+  query.goalPoint = goal->GetFactoryPoint();
+  query.callback = callback;
+  queries.push_back(query);
+}
+
+void PathService::RequestCost(SDL_Point start, StructureMachine *goal,
+                              std::function<void(unsigned int)> callback) {
+  Query query;
+  query.start = start;
+  query.goal = goal;
+  query.goalPoint = goal->GetFactoryPoint();
+  query.costCallback = callback;
+  queries.push_back(query);
+}
+
+void PathService::Solve() {
+  batch.clear();
+  batch.swap(queries);
+  // Queries to the same goal keep the order they were requested in.
+  std::stable_sort(batch.begin(), batch.end(),
+                   [this](const Query &lhs, const Query &rhs) {
+                     return ToTile(lhs.goalPoint) < ToTile(rhs.goalPoint);
+                   });
+  SDL_Point size = grid.GetSize();
+  std::size_t count = static_cast<std::size_t>(size.x) * size.y;
+  if (reached.size() != count) {
+    reached.assign(count, 0);
+    closed.assign(count, 0);
+    wanted.assign(count, 0);
+    gScore.resize(count);
+    towardGoal.resize(count);
+  }
+  std::size_t last = 0;
+  for (std::size_t first = 0; first < batch.size(); first = last) {
+    SDL_Point goal = batch[first].goalPoint;
+    for (last = first + 1; last < batch.size() &&
+                           ToTile(batch[last].goalPoint) == ToTile(goal);
+         last++)
+      ;
+    Search(goal, first, last);
+    for (std::size_t i = first; i < last; i++) {
+      if (batch[i].costCallback) {
+        batch[i].costCallback(ReadCost(batch[i].start, goal));
+        continue;
+      }
+      result.first = batch[i].goal;
+      ReadPath(batch[i].start, goal, result.second);
+      batch[i].callback(result);
+    }
+  }
+  batch.clear();
+}
+
+void PathService::Search(SDL_Point goal, std::size_t first,
+                         std::size_t last) {
+  if (++stamp == 0) {
+    // The stamps wrapped around, so earlier searches must be forgotten.
+    std::fill(reached.begin(), reached.end(), 0);
+    std::fill(closed.begin(), closed.end(), 0);
+    std::fill(wanted.begin(), wanted.end(), 0);
+    stamp = 1;
+  }
+  SDL_Point size = grid.GetSize();
+  starts.clear();
+  for (std::size_t i = first; i < last; i++) {
+    SDL_Point start = batch[i].start;
+    if (start.x < 0 || start.y < 0 || start.x >= size.x ||
+        start.y >= size.y || wanted[ToTile(start)] == stamp ||
+        !grid.IsConnected(start, goal))
+      continue;
+    wanted[ToTile(start)] = stamp;
+    starts.push_back(start);
+  }
+  // A goal on a blocked tile can only be reached by a robot standing on it.
+  if (starts.empty() || !grid.IsWalkable(goal))
+    return;
+
+  openQueue.clear();
+  int goalTile = ToTile(goal);
+  reached[goalTile] = stamp;
+  gScore[goalTile] = 0;
+  Push(goalTile, 0);
+  while (!starts.empty() && !openQueue.empty()) {
+    std::pop_heap(openQueue.begin(), openQueue.end(), OpenEntryCompare());
+    OpenEntry entry = openQueue.back();
+    openQueue.pop_back();
+    if (closed[entry.tile] == stamp)
+      continue;
+    closed[entry.tile] = stamp;
+    SDL_Point p = {entry.tile % size.x, entry.tile / size.x};
+    if (wanted[entry.tile] == stamp) {
+      Retarget(p);
+      // A robot may stand on a tile blocked after it got there, but paths
+      // only start from it.
+      if (!grid.IsWalkable(p))
+        continue;
+    }
+    for (int i = 0; i < EightWayNeighborhood::Count; i++) {
+      int dx = EightWayNeighborhood::Offsets[i][0];
+      int dy = EightWayNeighborhood::Offsets[i][1];
+      SDL_Point neighbor = {p.x + dx, p.y + dy};
+      if (neighbor.x < 0 || neighbor.y < 0 || neighbor.x >= size.x ||
+          neighbor.y >= size.y)
+        continue;
+      int tile = ToTile(neighbor);
+      if (closed[tile] == stamp ||
+          (!grid.IsWalkable(neighbor) && wanted[tile] != stamp))
+        continue;
+      unsigned int score = entry.gScore + EightWayNeighborhood::Cost(dx, dy);
+      if (reached[tile] == stamp && gScore[tile] <= score)
+        continue;
+      reached[tile] = stamp;
+      gScore[tile] = score;
+      towardGoal[tile] = entry.tile;
+      Push(tile, score);
+    }
+  }
+}
+
+void PathService::Push(int tile, unsigned int score) {
+  OpenEntry entry = {tile, score + CalcHScore(tile), score};
+  openQueue.push_back(entry);
+  std::push_heap(openQueue.begin(), openQueue.end(), OpenEntryCompare());
+}
+
+void PathService::Retarget(SDL_Point settled) {
+  for (std::size_t i = 0; i < starts.size(); i++) {
+    if (starts[i].x == settled.x && starts[i].y == settled.y) {
+      starts[i] = starts.back();
+      starts.pop_back();
+      break;
+    }
+  }
+  if (starts.size() > MAX_TARGETED_STARTS)
+    return;
+  // The expanded tiles already have their shortest costs, so the search
+  // goes on towards the remaining starts with the queue ordered again.
+  for (OpenEntry &entry : openQueue)
+    entry.fScore = entry.gScore + CalcHScore(entry.tile);
+  std::make_heap(openQueue.begin(), openQueue.end(), OpenEntryCompare());
+}
+
+unsigned int PathService::CalcHScore(int tile) const {
+  // The estimate to the nearest start is consistent, so every start is
+  // settled with the cost of its shortest path.
+  if (starts.size() > MAX_TARGETED_STARTS)
+    return 0;
+  SDL_Point size = grid.GetSize();
+  SDL_Point p = {tile % size.x, tile / size.x};
+  unsigned int hScore = UINT_MAX;
+  for (const SDL_Point &start : starts)
+    hScore = std::min(hScore, SearchPathAlgorithm::CalcHScore(p, start));
+  return hScore;
+}
+
+unsigned int PathService::ReadCost(SDL_Point start, SDL_Point goal) const {
+  if (start.x == goal.x && start.y == goal.y)
+    return 0;
+  SDL_Point size = grid.GetSize();
+  if (start.x < 0 || start.y < 0 || start.x >= size.x || start.y >= size.y ||
+      closed[ToTile(start)] != stamp)
+    return UINT_MAX;
+  return gScore[ToTile(start)];
+}
+
+void PathService::ReadPath(SDL_Point start, SDL_Point goal,
+                           std::vector<SDL_Point> &path) {
+  path.clear();
+  if (start.x == goal.x && start.y == goal.y) {
+    path.push_back(goal);
+    return;
+  }
+  SDL_Point size = grid.GetSize();
+  if (start.x < 0 || start.y < 0 || start.x >= size.x || start.y >= size.y ||
+      closed[ToTile(start)] != stamp)
+    return;
+  // The search tree leads from the start to the goal, which is the bottom of
+  // the stack.
+  int goalTile = ToTile(goal);
+  for (int tile = ToTile(start); tile != goalTile; tile = towardGoal[tile]) {
+    SDL_Point p = {tile % size.x, tile / size.x};
+    path.push_back(p);
+  }
+  path.push_back(goal);
+  std::reverse(path.begin(), path.end());
+}
@@ -0,0 +1,217 @@
+/*******************************************************************************
+@file `PathService.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include "SearchPathAlgorithm.h"
+#include "StructureMachine.h"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * `PathService`
+ *
+ *   Answers a batch of path queries at once, with one search per goal.
+ *
+ * @description
+ *   Queries are collected with `Request` or `RequestCost` and answered by
+ *   `Solve`. Queries to
+ *   the same goal tile are grouped, and each group is answered by a single
+ *   search grown backward from the goal until every start of the group is
+ *   settled. Steps cost the same both ways, so the path from each start is
+ *   read off the search tree. The work grows with the number of distinct
+ *   goals rather than with the number of queries.
+ *
+ *   The search uses the same neighborhood and heuristic as
+ *   `SearchPathAlgorithm`, towards the nearest start of the group, so the
+ *   paths are as short. Starts known to be in another component than the goal
+ *   are answered without searching.
+ *
+ *   The working buffers cover the whole map and are kept between calls.
+ *
+ *   The factory uses the service only with batched assignment, to find the
+ *   path costs from every waiting robot to every candidate at once and then
+ *   the paths of the assigned pairs. Robots picking their own targets,
+ *   including those picking again because their target was claimed, search
+ *   one path at a time and prune candidates that cannot be nearer, which the
+ *   service cannot do. Their searches also spread over updates within the
+ *   anytime budget, while the service answers only at the next `Solve`.
+ */
+class PathService {
+public:
+  /**
+   * `TargetPath`
+   *
+   *   The answer to a query: the goal machine and the path towards it, as a
+   *   stack from the goal down to the start, or empty if it is unreachable.
+   */
+  using TargetPath = std::pair<StructureMachine *, std::vector<SDL_Point>>;
+
+private:
+  /**
+   * `Query`
+   *
+   *   A requested path or path cost and the function to be called with it.
+   */
+  struct Query {
+    SDL_Point start;
+    StructureMachine *goal;
+    SDL_Point goalPoint;
+    std::function<void(TargetPath &)> callback;
+    std::function<void(unsigned int)> costCallback;
+  };
+
+  /**
+   * `OpenEntry`
+   *
+   *   A tile on the open queue with its scores when it was pushed.
+   */
+  struct OpenEntry {
+    int tile;
+    unsigned int fScore;
+    unsigned int gScore;
+  };
+  struct OpenEntryCompare {
+    bool operator()(const OpenEntry &lhs, const OpenEntry &rhs) const {
+      return lhs.fScore != rhs.fScore ? lhs.fScore > rhs.fScore
+                                      : lhs.gScore < rhs.gScore;
+    }
+  };
+
+  /**
+   * `grid`
+   *
+   *   The walkable tiles of the map.
+   */
+  WalkableGrid grid;
+
+  /**
+   * `queries`
+   *
+   *   The queries waiting for the next `Solve`.
+   */
+  std::vector<Query> queries;
+
+  /**
+   * `batch`
+   *
+   *   The queries being answered, sorted by goal.
+   */
+  std::vector<Query> batch;
+
+  /**
+   * `stamp`
+   *
+   *   The number of the current search. Tiles stamped by earlier searches are
+   *   treated as unvisited, so the buffers are not cleared between searches.
+   */
+  unsigned int stamp;
+
+  /**
+   * `reached`, `closed`, `wanted`
+   *
+   *   The stamp of the last search that reached, expanded or had a start on
+   *   each tile.
+   */
+  std::vector<unsigned int> reached;
+  std::vector<unsigned int> closed;
+  std::vector<unsigned int> wanted;
+
+  /**
+   * `gScore`
+   *
+   *   The cost from the goal to each reached tile.
+   */
+  std::vector<unsigned int> gScore;
+
+  /**
+   * `towardGoal`
+   *
+   *   The next tile on the way to the goal from each reached tile.
+   */
+  std::vector<int> towardGoal;
+
+  /**
+   * `openQueue`
+   *
+   *   The heap of tiles to be expanded.
+   */
+  std::vector<OpenEntry> openQueue;
+
+  /**
+   * `starts`
+   *
+   *   The distinct start tiles of the current group not settled yet.
+   */
+  std::vector<SDL_Point> starts;
+
+  /**
+   * `result`
+   *
+   *   The answer passed to the callback of each query.
+   */
+  TargetPath result;
+
+public:
+  /**
+   * `PathService`
+   *
+   *   Constructor.
+   *
+   * @param walkableGrid
+   *   The walkable tiles of the map.
+   */
+  PathService(const WalkableGrid &walkableGrid);
+
+  /**
+   * `Request`
+   *
+   *   Queues a query for a path from the start to the goal machine.
+   *
+   * @param callback
+   *   The function to be called by `Solve` with the goal and the path.
+   */
+  void Request(SDL_Point start, StructureMachine *goal,
+               std::function<void(TargetPath &)> callback);
+
+  /**
+   * `RequestCost`
+   *
+   *   Queues a query for the cost of the path from the start to the goal
+   *   machine, without the path itself.
+   *
+   * @param callback
+   *   The function to be called by `Solve` with the cost of the path, in the
+   *   fixed-point units of `EightWayNeighborhood::Cost`, or `UINT_MAX` if the
+   *   goal is unreachable.
+   */
+  void RequestCost(SDL_Point start, StructureMachine *goal,
+                   std::function<void(unsigned int)> callback);
+
+  /**
+   * `Solve`
+   *
+   *   Answers every queued query, one goal at a time.
+   *
+   * @description
+   *   Queries made by the callbacks are answered at the next call.
+   */
+  void Solve();
+
+private:
+  void Search(SDL_Point goal, std::size_t first, std::size_t last);
+  void Push(int tile, unsigned int score);
+  void Retarget(SDL_Point settled);
+  unsigned int CalcHScore(int tile) const;
+  unsigned int ReadCost(SDL_Point start, SDL_Point goal) const;
+  void ReadPath(SDL_Point start, SDL_Point goal, std::vector<SDL_Point> &path);
+  int ToTile(SDL_Point p) const { return p.y * grid.GetSize().x + p.x; }
+};
@@ -7,18 +7,23 @@
 *******************************************************************************/
 
 #include "PickTargetAlgorithm.h"
+#include <algorithm>
+#include <iterator>
 
 PickTargetAlgorithm::PickTargetAlgorithm(
     std::function<void(std::pair<StructureMachine *, std::vector<SDL_Point>> &)>
         resultCallback,
-    std::function<std::vector<SDL_Point>(SDL_Point)> getNeighborsCallback)
+    std::function<void(std::vector<SDL_Point> &)> provisionalCallback,
+    const WalkableGrid &walkableGrid)
     : IterativeAlgorithm<std::pair<StructureMachine *, std::vector<SDL_Point>>,
                          SDL_Point, std::vector<StructureMachine *>>(
           resultCallback),
-      getNeighbors(getNeighborsCallback),
+      grid(walkableGrid),
       searchPath(new SearchPathAlgorithm(
           [this](std::vector<SDL_Point> &path) { this->ReceivePath(path); },
-          getNeighborsCallback)) {}
+          walkableGrid)),
+      provisionalCallback(provisionalCallback), anytimeBudget(0),
+      iterations(0) {}
 
 PickTargetAlgorithm::~PickTargetAlgorithm() { delete searchPath; }
 
@@ -28,26 +33,219 @@ bool PickTargetAlgorithm::Begin(SDL_Point origin,
   candidatesArg = candidates;
   result.first = NULL;
   result.second.clear();
+  evaluations.clear();
+  prunedCandidates.clear();
+  iterations = 0;
+  candidatesArg.remove_if([this](StructureMachine *candidate) {
+    return !grid.IsConnected(originArg, candidate->GetFactoryPoint());
+  });
   if (candidatesArg.empty())
     return false;
+  OrderCandidates();
   return searchPath->Begin(originArg,
                            candidatesArg.back()->GetFactoryPoint()) ||
          !candidatesArg.empty();
 }
 
 bool PickTargetAlgorithm::Next() {
-  return searchPath->Next() || !candidatesArg.empty();
+  if (!searchPath->Next() && candidatesArg.empty())
+    return false;
+  if (!candidatesArg.empty() && !CanBeat(searchPath->GetMinSteps())) {
+    searchPath->Cancel();
+    prunedCandidates.push_back(candidatesArg.back());
+    candidatesArg.pop_back();
+    NextCandidate();
+    // The result may have been returned, and nothing is left to publish.
+    if (candidatesArg.empty())
+      return false;
+  }
+  if (anytimeBudget > 0 && ++iterations % anytimeBudget == 0)
+    PublishProvisionalPath();
+  return true;
+}
+
+void PickTargetAlgorithm::AddCandidate(StructureMachine *candidate) {
+  if (!candidatesArg.empty() &&
+      grid.IsConnected(originArg, candidate->GetFactoryPoint()))
+    InsertCandidate(candidate);
+}
+
+void PickTargetAlgorithm::RemoveCandidate(StructureMachine *candidate) {
+  if (candidatesArg.empty())
+    return;
+  if (candidate == candidatesArg.back()) {
+    searchPath->Cancel();
+    candidatesArg.pop_back();
+    NextCandidate();
+    return;
+  }
+  candidatesArg.remove(candidate);
+  prunedCandidates.erase(std::remove(prunedCandidates.begin(),
+                                     prunedCandidates.end(), candidate),
+                         prunedCandidates.end());
+  auto evaluation =
+      std::find_if(evaluations.begin(), evaluations.end(),
+                   [candidate](const Evaluation &e) {
+                     return e.candidate == candidate;
+                   });
+  if (evaluation == evaluations.end())
+    return;
+  evaluations.erase(evaluation);
+  if (candidate != result.first)
+    return;
+
+  // The pruned candidates may beat the next best one, which is searched again
+  // right after the current search so that they can be pruned against it.
+  result.first = NULL;
+  result.second.clear();
+  for (StructureMachine *pruned : prunedCandidates)
+    InsertCandidate(pruned);
+  prunedCandidates.clear();
+  auto best = std::min_element(evaluations.begin(), evaluations.end(),
+                               [](const Evaluation &a, const Evaluation &b) {
+                                 return a.length < b.length;
+                               });
+  if (best != evaluations.end()) {
+    candidatesArg.insert(std::prev(candidatesArg.end()), best->candidate);
+    evaluations.erase(best);
+  }
+}
+
+void PickTargetAlgorithm::Save(Snapshot &snapshot) const {
+  snapshot.Write(originArg);
+  snapshot.Write(iterations);
+  snapshot.WriteMachine(result.first);
+  snapshot.WriteVector(result.second);
+  snapshot.Write(static_cast<Uint64>(evaluations.size()));
+  for (const Evaluation &e : evaluations) {
+    snapshot.WriteMachine(e.candidate);
+    snapshot.Write(static_cast<Uint64>(e.length));
+  }
+  snapshot.Write(static_cast<Uint64>(candidatesArg.size()));
+  for (StructureMachine *candidate : candidatesArg)
+    snapshot.WriteMachine(candidate);
+  snapshot.Write(static_cast<Uint64>(prunedCandidates.size()));
+  for (StructureMachine *candidate : prunedCandidates)
+    snapshot.WriteMachine(candidate);
+  searchPath->Save(snapshot);
+}
+
+void PickTargetAlgorithm::Restore(Snapshot &snapshot) {
+  snapshot.Read(originArg);
+  snapshot.Read(iterations);
+  result.first = static_cast<StructureMachine *>(snapshot.ReadMachine());
+  snapshot.ReadVector(result.second);
+  evaluations.resize(snapshot.ReadCount(sizeof(Sint32) + sizeof(Uint64)));
+  for (Evaluation &e : evaluations) {
+    Uint64 length = 0;
+    e.candidate = static_cast<StructureMachine *>(snapshot.ReadMachine());
+    snapshot.Read(length);
+    e.length = static_cast<std::size_t>(length);
+  }
+  std::size_t count = snapshot.ReadCount(sizeof(Sint32));
+  candidatesArg.clear();
+  for (std::size_t n = 0; n < count; n++)
+    candidatesArg.push_back(
+        static_cast<StructureMachine *>(snapshot.ReadMachine()));
+  prunedCandidates.resize(snapshot.ReadCount(sizeof(Sint32)));
+  for (StructureMachine *&candidate : prunedCandidates)
+    candidate = static_cast<StructureMachine *>(snapshot.ReadMachine());
+  searchPath->Restore(snapshot);
 }
 
 void PickTargetAlgorithm::ReceivePath(std::vector<SDL_Point> &path) {
-  if (result.second.empty() ||
-      (!path.empty() && path.size() < result.second.size())) {
+  // An empty path means the candidate is unreachable.
+  if (!path.empty()) {
+    Evaluation evaluation;
+    evaluation.candidate = candidatesArg.back();
+    evaluation.length = path.size();
+    evaluations.push_back(evaluation);
+  }
+  if (!path.empty() &&
+      (result.second.empty() || path.size() < result.second.size())) {
     result.first = candidatesArg.back();
     result.second = path;
   }
   candidatesArg.pop_back();
+  NextCandidate();
+}
+
+void PickTargetAlgorithm::NextCandidate() {
+  while (!candidatesArg.empty() &&
+         !CanBeat(CalcMinSteps(candidatesArg.back()))) {
+    prunedCandidates.push_back(candidatesArg.back());
+    candidatesArg.pop_back();
+  }
   if (candidatesArg.empty())
     Return(result);
   else
     searchPath->Begin(originArg, candidatesArg.back()->GetFactoryPoint());
 }
+
+void PickTargetAlgorithm::PublishProvisionalPath() {
+  // A complete path to a candidate beats a partial one towards another.
+  if (!result.second.empty())
+    provisional = result.second;
+  else
+    searchPath->GetPartialPath(provisional);
+  // A path of one point leads nowhere from the origin.
+  if (provisional.size() > 1)
+    provisionalCallback(provisional);
+}
+
+void PickTargetAlgorithm::OrderCandidates() {
+  std::vector<StructureMachine *> candidates(candidatesArg.begin(),
+                                             candidatesArg.end());
+  std::size_t count = candidates.size();
+  std::vector<int> dx(count);
+  std::vector<int> dy(count);
+  std::vector<unsigned int> bounds(count);
+  for (std::size_t i = 0; i < count; i++) {
+    SDL_Point &p = candidates[i]->GetFactoryPoint();
+    dx[i] = p.x - originArg.x;
+    dy[i] = p.y - originArg.y;
+  }
+  // A plain loop over the arrays, which the compiler can vectorize.
+  for (std::size_t i = 0; i < count; i++)
+    bounds[i] = SearchPathAlgorithm::CalcMinSteps(
+        static_cast<unsigned int>(dx[i] < 0 ? -dx[i] : dx[i]),
+        static_cast<unsigned int>(dy[i] < 0 ? -dy[i] : dy[i]));
+
+  // The nearest candidate goes last so that it is searched first. Ties keep
+  // their order so that the pick does not depend on addresses.
+  std::vector<std::size_t> order(count);
+  for (std::size_t i = 0; i < count; i++)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&bounds](std::size_t a, std::size_t b) {
+                     return bounds[a] > bounds[b];
+                   });
+  candidatesArg.clear();
+  for (std::size_t i : order)
+    candidatesArg.push_back(candidates[i]);
+}
+
+void PickTargetAlgorithm::InsertCandidate(StructureMachine *candidate) {
+  // The candidate being searched stays last.
+  unsigned int minSteps = CalcMinSteps(candidate);
+  auto position = candidatesArg.begin();
+  while (position != std::prev(candidatesArg.end()) &&
+         CalcMinSteps(*position) > minSteps)
+    ++position;
+  candidatesArg.insert(position, candidate);
+}
+
+unsigned int
+PickTargetAlgorithm::CalcMinSteps(StructureMachine *candidate) const {
+  SDL_Point &p = candidate->GetFactoryPoint();
+  int dx = p.x - originArg.x;
+  int dy = p.y - originArg.y;
+  return SearchPathAlgorithm::CalcMinSteps(
+      static_cast<unsigned int>(dx < 0 ? -dx : dx),
+      static_cast<unsigned int>(dy < 0 ? -dy : dy));
+}
+
+bool PickTargetAlgorithm::CanBeat(unsigned int minSteps) const {
+  // The path includes the origin, and only a shorter path replaces the best.
+  return result.second.empty() || minSteps + 1 < result.second.size();
+}
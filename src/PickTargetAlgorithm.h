@@ -21,6 +21,13 @@
  * `PickTargetAlgorithm`
  *
  *   Picks a target with the shortest path from a given set of candidates.
+ *
+ * @description
+ *   Candidates in another component of the walkable tiles than the origin
+ *   are dropped before any search. The others are searched from the nearest
+ *   to the farthest as the crow flies. Once a path is found, a candidate
+ *   whose fewest possible steps cannot beat it is skipped, and a search is
+ *   abandoned as soon as its lower bound rises that far.
  */
 class PickTargetAlgorithm
     : public IterativeAlgorithm<
@@ -28,11 +35,14 @@ class PickTargetAlgorithm
           std::vector<StructureMachine *>> {
 
   /**
-   * `getNeighbors`
+   * `Evaluation`
    *
-   *   The function that returns valid neighbors from a given point.
+   *   A candidate whose path has been searched, with the length of the path.
    */
-  std::function<std::vector<SDL_Point>(SDL_Point)> getNeighbors;
+  struct Evaluation {
+    StructureMachine *candidate;
+    std::size_t length;
+  };
 
   /**
    * `result`
@@ -44,10 +54,27 @@ class PickTargetAlgorithm
   /**
    * `candidatesArg`
    *
-   *   The collection of candidate machines from which to choose.
+   *   The candidate machines whose paths are still to be searched, from the
+   *   farthest to the nearest. The path to the last one is being searched.
    */
   std::list<StructureMachine *> candidatesArg;
 
+  /**
+   * `prunedCandidates`
+   *
+   *   The candidates skipped or abandoned because they could not beat the best
+   *   path found so far.
+   */
+  std::vector<StructureMachine *> prunedCandidates;
+
+  /**
+   * `evaluations`
+   *
+   *   The reachable candidates whose paths have been searched. Only the path to
+   *   the best of them is kept, in `result`.
+   */
+  std::vector<Evaluation> evaluations;
+
   /**
    * `originArg`
    *
@@ -55,6 +82,14 @@ class PickTargetAlgorithm
    */
   SDL_Point originArg;
 
+  /**
+   * `grid`
+   *
+   *   The walkable tiles of the map, used to drop unreachable candidates
+   *   before they are searched.
+   */
+  WalkableGrid grid;
+
   /**
    * `searchPath`
    *
@@ -63,6 +98,36 @@ class PickTargetAlgorithm
    */
   SearchPathAlgorithm *searchPath;
 
+  /**
+   * `provisionalCallback`
+   *
+   *   The function to be called with a provisional path while the search is
+   *   still in progress.
+   */
+  std::function<void(std::vector<SDL_Point> &)> provisionalCallback;
+
+  /**
+   * `anytimeBudget`
+   *
+   *   The number of iterations between provisional paths, or 0 if none are
+   *   published.
+   */
+  unsigned int anytimeBudget;
+
+  /**
+   * `iterations`
+   *
+   *   The number of iterations since the algorithm began.
+   */
+  unsigned int iterations;
+
+  /**
+   * `provisional`
+   *
+   *   The most recent provisional path.
+   */
+  std::vector<SDL_Point> provisional;
+
 public:
   /**
    * `PickTargetAlgorithm`
@@ -73,14 +138,19 @@ public:
    *   The function to be called when the result is ready. The result is a pair
    *   containing a machine with its associated path.
    *
-   * @param getNeighborsCallback
-   *   The function that returns valid neighbors from a given point.
+   * @param provisionalCallback
+   *   The function to be called with a provisional path from the origin. See
+   *   `SetAnytimeBudget`.
+   *
+   * @param walkableGrid
+   *   The walkable tiles of the map.
    */
   PickTargetAlgorithm(
       std::function<
           void(std::pair<StructureMachine *, std::vector<SDL_Point>> &)>
           resultCallback,
-      std::function<std::vector<SDL_Point>(SDL_Point)> getNeighborsCallback);
+      std::function<void(std::vector<SDL_Point> &)> provisionalCallback,
+      const WalkableGrid &walkableGrid);
 
   /**
    * `~PickTargetAlgorithm`
@@ -109,6 +179,71 @@ public:
    */
   bool Next();
 
+  /**
+   * `SetAnytimeBudget`
+   *
+   *   Sets the number of iterations after which, and every so many iterations
+   *   after that, a provisional path is published while the search goes on.
+   *   Zero disables provisional paths.
+   *
+   * @description
+   *   The provisional path leads to the best candidate evaluated so far or,
+   *   before any candidate is reached, to the most promising point on the
+   *   frontier of the current search. No target comes with it; the target is
+   *   only known once every candidate has been searched.
+   */
+  void SetAnytimeBudget(unsigned int value) { anytimeBudget = value; }
+
+  /**
+   * `AddCandidate`
+   *
+   *   Adds a candidate to a search in progress. It waits among the other
+   *   candidates by its distance, after the one being searched.
+   */
+  void AddCandidate(StructureMachine *candidate);
+
+  /**
+   * `RemoveCandidate`
+   *
+   *   Removes a candidate, such as one claimed by another robot, from a search
+   *   in progress without discarding the work done for the others.
+   *
+   * @description
+   *   A candidate still waiting is simply dropped, and a candidate whose path
+   *   is being searched is abandoned for the next one. If the removed
+   *   candidate was the best found so far, the next best evaluated candidate
+   *   is searched again to recover its path, and the pruned candidates are
+   *   waiting again; no other path is searched again.
+   */
+  void RemoveCandidate(StructureMachine *candidate);
+
+  /**
+   * `Save`
+   *
+   *   Writes the state of the algorithm to a snapshot.
+   */
+  void Save(Snapshot &snapshot) const;
+
+  /**
+   * `Restore`
+   *
+   *   Reads the state of the algorithm from a snapshot.
+   */
+  void Restore(Snapshot &snapshot);
+
+  /**
+   * `GetOpenSetSize`
+   *
+   *   Gets the number of points in the open set of the current path search.
+   */
+  std::size_t GetOpenSetSize() const { return searchPath->GetOpenSetSize(); }
+
 private:
   void ReceivePath(std::vector<SDL_Point> &path);
+  void NextCandidate();
+  void PublishProvisionalPath();
+  void OrderCandidates();
+  void InsertCandidate(StructureMachine *candidate);
+  unsigned int CalcMinSteps(StructureMachine *candidate) const;
+  bool CanBeat(unsigned int minSteps) const;
 };
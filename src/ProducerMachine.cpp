@@ -14,8 +14,9 @@ static SDL_Rect makeSDL_Rect(int x, int y, int w, int h) {
 }
 
 ProducerMachine::ProducerMachine(SDL_Texture *const spritesheet,
-                                 SDL_Rect drawRegion, SDL_Point factoryPoint)
+                                 SDL_Rect drawRegion, SDL_Point factoryPoint,
+                                 unsigned int busyDelay)
     : StructureMachine(spritesheet, makeSDL_Rect(0, 32, 32, 16),
                        makeSDL_Rect(16, 32, 32, 16),
                        makeSDL_Rect(48, 0, 32, 80), drawRegion, factoryPoint,
-                       5000) {}
+                       busyDelay) {}
@@ -32,7 +32,10 @@ public:
    *
    * @param factoryPoint
    *   The factory coordinates of the machine.
+   *
+   * @param busyDelay
+   *   The number of ticks the machine will be busy.
    */
   ProducerMachine(SDL_Texture *const spritesheet, SDL_Rect drawRegion,
-                  SDL_Point factoryPoint);
+                  SDL_Point factoryPoint, unsigned int busyDelay = 5000);
 };
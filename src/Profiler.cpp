@@ -0,0 +1,129 @@
+/*******************************************************************************
+@file `Profiler.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "Profiler.h"
+#include <algorithm>
+#include <mutex>
+
+/**
+ * `PROFILER_FRAME_COUNT`
+ *
+ *   The number of recent frames kept in the ring buffer.
+ */
+#define PROFILER_FRAME_COUNT 256
+
+/**
+ * `ZONE_COUNT`
+ *
+ *   The number of profile zones.
+ */
+#define ZONE_COUNT static_cast<int>(ProfileZone::Count)
+
+/**
+ * `OVERLAY_BUDGET_WIDTH`
+ *
+ *   The overlay width in pixels of a 60 Hz frame.
+ */
+#define OVERLAY_BUDGET_WIDTH 200
+
+static const char *const zoneNames[ZONE_COUNT] = {
+    "Update", "Stations", "Robots", "Assignment",
+    "PathSearch", "Events", "Draw"};
+
+static const Uint8 zoneColors[ZONE_COUNT][3] = {
+    {0xFF, 0xFF, 0xFF}, {0x40, 0xC0, 0x40}, {0x40, 0x80, 0xFF},
+    {0xC0, 0x40, 0xC0}, {0xFF, 0xA0, 0x20}, {0xFF, 0x40, 0x40},
+    {0x40, 0xE0, 0xE0}};
+
+static thread_local Uint64 threadFrame[ZONE_COUNT];
+static Uint64 currentFrame[ZONE_COUNT];
+static std::mutex currentFrameMutex;
+static Uint64 frames[PROFILER_FRAME_COUNT][ZONE_COUNT];
+static int frameIndex = 0;
+static int frameCount = 0;
+
+std::atomic<bool> Profiler::enabled(false);
+
+void Profiler::Add(ProfileZone zone, Uint64 counts) {
+  threadFrame[static_cast<int>(zone)] += counts;
+}
+
+void Profiler::FlushThread() {
+  std::lock_guard<std::mutex> lock(currentFrameMutex);
+  for (int i = 0; i < ZONE_COUNT; i++)
+    currentFrame[i] += threadFrame[i];
+  std::fill(threadFrame, threadFrame + ZONE_COUNT, 0);
+}
+
+void Profiler::EndFrame() {
+  if (!IsEnabled())
+    return;
+  std::lock_guard<std::mutex> lock(currentFrameMutex);
+  for (int i = 0; i < ZONE_COUNT; i++)
+    currentFrame[i] += threadFrame[i];
+  std::fill(threadFrame, threadFrame + ZONE_COUNT, 0);
+  std::copy(currentFrame, currentFrame + ZONE_COUNT, frames[frameIndex]);
+  std::fill(currentFrame, currentFrame + ZONE_COUNT, 0);
+  frameIndex = (frameIndex + 1) % PROFILER_FRAME_COUNT;
+  frameCount = std::min(frameCount + 1, PROFILER_FRAME_COUNT);
+}
+
+double Profiler::GetPercentile(ProfileZone zone, int percentile) {
+  Uint64 samples[PROFILER_FRAME_COUNT];
+  int count;
+  {
+    std::lock_guard<std::mutex> lock(currentFrameMutex);
+    count = frameCount;
+    for (int i = 0; i < count; i++)
+      samples[i] = frames[i][static_cast<int>(zone)];
+  }
+  if (count == 0)
+    return 0.0;
+  int n = (count - 1) * percentile / 100;
+  std::nth_element(samples, samples + n, samples + count);
+  return 1000.0 * static_cast<double>(samples[n]) /
+         static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+void Profiler::LogSummary() {
+  int count;
+  {
+    std::lock_guard<std::mutex> lock(currentFrameMutex);
+    count = frameCount;
+  }
+  SDL_Log("Profile of the last %d frames (ms):", count);
+  for (int i = 0; i < ZONE_COUNT; i++) {
+    ProfileZone zone = static_cast<ProfileZone>(i);
+    SDL_Log("  %-10s p50 %7.3f  p95 %7.3f  p99 %7.3f", zoneNames[i],
+            GetPercentile(zone, 50), GetPercentile(zone, 95),
+            GetPercentile(zone, 99));
+  }
+}
+
+void Profiler::DrawOverlay(SDL_Renderer *sdlRenderer, int x, int y) {
+  Uint8 r, g, b, a;
+  SDL_GetRenderDrawColor(sdlRenderer, &r, &g, &b, &a);
+  SDL_SetRenderDrawColor(sdlRenderer, 0x80, 0x80, 0x80, 0xFF);
+  SDL_Rect budget = {x + OVERLAY_BUDGET_WIDTH, y, 1, ZONE_COUNT * 8};
+  SDL_RenderFillRect(sdlRenderer, &budget);
+  for (int i = 0; i < ZONE_COUNT; i++) {
+    ProfileZone zone = static_cast<ProfileZone>(i);
+    const Uint8 *color = zoneColors[i];
+    double scale = OVERLAY_BUDGET_WIDTH / (1000.0 / 60.0);
+    SDL_Rect p95 = {x, y + i * 8,
+                    static_cast<int>(GetPercentile(zone, 95) * scale) + 1, 6};
+    SDL_SetRenderDrawColor(sdlRenderer, color[0] / 2, color[1] / 2,
+                           color[2] / 2, 0xFF);
+    SDL_RenderFillRect(sdlRenderer, &p95);
+    SDL_Rect p50 = {x, y + i * 8,
+                    static_cast<int>(GetPercentile(zone, 50) * scale) + 1, 6};
+    SDL_SetRenderDrawColor(sdlRenderer, color[0], color[1], color[2], 0xFF);
+    SDL_RenderFillRect(sdlRenderer, &p50);
+  }
+  SDL_SetRenderDrawColor(sdlRenderer, r, g, b, a);
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+@file `Profiler.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+
+/**
+ * `ProfileZone`
+ *
+ *   The instrumented subsystems.
+ *
+ * @description
+ *   Zones are inclusive; for example, the time spent in `Events` while robots
+ *   are updated is also counted in `Robots` and `Update`, and the searches
+ *   begun by event handlers are counted in both `PathSearch` and `Events`.
+ */
+enum class ProfileZone {
+  Update,
+  Stations,
+  Robots,
+  Assignment,
+  PathSearch,
+  Events,
+  Draw,
+  Count
+};
+
+/**
+ * `Profiler`
+ *
+ *   Collects per-frame timings of each profile zone.
+ *
+ * @description
+ *   Time spent in each zone is accumulated over a frame using the
+ *   high-resolution performance counter. At the end of each frame the totals
+ *   are stored in a ring buffer of recent frames, from which percentiles are
+ *   reported in the log and in an on-screen overlay.
+ *
+ *   When the profiler is disabled, a `ProfileScope` costs a single branch.
+ *
+ *   Each thread accumulates into its own totals, which worker threads merge
+ *   with `FlushThread` when they finish their share of a parallel loop. Zones
+ *   timed on several threads at once therefore report the total time spent
+ *   on all of them, which may exceed the length of the frame.
+ *
+ *   Frames may be ended on one thread while the percentiles are read on
+ *   another, so the ring buffer is only touched under the lock.
+ */
+class Profiler {
+
+  /**
+   * `enabled`
+   *
+   *   True if timings are being collected; otherwise, false.
+   */
+  static std::atomic<bool> enabled;
+
+public:
+  /**
+   * `IsEnabled`
+   *
+   *   True if timings are being collected; otherwise, false.
+   */
+  static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+  /**
+   * `SetEnabled`
+   *
+   *   Starts or stops collecting timings.
+   */
+  static void SetEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * `Add`
+   *
+   *   Adds performance counter ticks to a zone of the current frame.
+   */
+  static void Add(ProfileZone zone, Uint64 counts);
+
+  /**
+   * `FlushThread`
+   *
+   *   Merges the totals of the calling thread into the current frame.
+   */
+  static void FlushThread();
+
+  /**
+   * `EndFrame`
+   *
+   *   Stores the totals of the current frame in the ring buffer.
+   */
+  static void EndFrame();
+
+  /**
+   * `GetPercentile`
+   *
+   *   Gets the given percentile of a zone over the recorded frames, in
+   *   milliseconds.
+   */
+  static double GetPercentile(ProfileZone zone, int percentile);
+
+  /**
+   * `LogSummary`
+   *
+   *   Logs the p50, p95 and p99 of each zone.
+   */
+  static void LogSummary();
+
+  /**
+   * `DrawOverlay`
+   *
+   *   Draws a bar for each zone at the given point on the renderer. The bright
+   *   bar is the p50 and the dim bar the p95, against a 60 Hz frame budget.
+   */
+  static void DrawOverlay(SDL_Renderer *sdlRenderer, int x, int y);
+};
+
+/**
+ * `ProfileScope`
+ *
+ *   Adds the time between its construction and destruction to a zone.
+ */
+class ProfileScope {
+  ProfileZone zone;
+  Uint64 start;
+
+public:
+  ProfileScope(ProfileZone profileZone)
+      : zone(profileZone),
+        start(Profiler::IsEnabled() ? SDL_GetPerformanceCounter() : 0) {}
+  ~ProfileScope() {
+    if (start != 0)
+      Profiler::Add(zone, SDL_GetPerformanceCounter() - start);
+  }
+};
@@ -0,0 +1,39 @@
+/*******************************************************************************
+@file `RenderBuffer.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "RenderBuffer.h"
+
+/**
+ * `FRESH_BIT`
+ *
+ *   Set on the middle index when it holds a state not yet acquired.
+ */
+#define FRESH_BIT 4u
+
+/**
+ * `INDEX_MASK`
+ *
+ *   The bits of the middle index that select a state.
+ */
+#define INDEX_MASK 3u
+
+RenderBuffer::RenderBuffer() : middle(1), back(0), front(2) {}
+
+void RenderBuffer::Publish() {
+  // Releasing the captured state and acquiring the stale one, whose last
+  // reader is done with it.
+  back = middle.exchange(back | FRESH_BIT, std::memory_order_acq_rel) &
+         INDEX_MASK;
+}
+
+bool RenderBuffer::Acquire() {
+  if (!(middle.load(std::memory_order_relaxed) & FRESH_BIT))
+    return false;
+  front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+  return true;
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+@file `RenderBuffer.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include "RenderState.h"
+#include <atomic>
+
+/**
+ * `RenderBuffer`
+ *
+ *   Passes render states from the simulation thread to the render thread
+ *   without either ever waiting for the other.
+ *
+ * @description
+ *   There are three states. The simulation captures into the back state and
+ *   the render thread draws the front state, while the middle state holds
+ *   the latest published one. Publishing swaps the back state with the
+ *   middle one, and acquiring swaps the middle state with the front one if
+ *   it is newer, each with a single atomic exchange. States published while
+ *   the render thread is busy replace each other, so the render thread
+ *   always draws the newest state and the simulation never waits for a
+ *   present.
+ *
+ *   Only one thread may publish and only one may acquire.
+ */
+class RenderBuffer {
+
+  /**
+   * `states`
+   *
+   *   The back, middle and front states, in no fixed order.
+   */
+  RenderState states[3];
+
+  /**
+   * `middle`
+   *
+   *   The index of the middle state, with `FRESH_BIT` set if it was published
+   *   since it was last acquired.
+   */
+  std::atomic<unsigned int> middle;
+
+  /**
+   * `back`
+   *
+   *   The index of the state owned by the simulation thread.
+   */
+  unsigned int back;
+
+  /**
+   * `front`
+   *
+   *   The index of the state owned by the render thread.
+   */
+  unsigned int front;
+
+public:
+  /**
+   * `RenderBuffer`
+   *
+   *   Constructor. The front state is empty until a state is acquired.
+   */
+  RenderBuffer();
+
+  /**
+   * `GetBack`
+   *
+   *   Gets the state to be captured into by the simulation thread.
+   */
+  RenderState &GetBack() { return states[back]; }
+
+  /**
+   * `Publish`
+   *
+   *   Makes the back state the newest one and takes another back state.
+   */
+  void Publish();
+
+  /**
+   * `Acquire`
+   *
+   *   Makes the newest published state the front state.
+   *
+   * @returns
+   *   True if a state was published since the last call; otherwise, false.
+   */
+  bool Acquire();
+
+  /**
+   * `GetFront`
+   *
+   *   Gets the state to be drawn by the render thread.
+   */
+  const RenderState &GetFront() const { return states[front]; }
+};
@@ -0,0 +1,34 @@
+/*******************************************************************************
+@file `RenderState.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "RenderState.h"
+#include "Profiler.h"
+
+void RenderState::Clear() {
+  floor.clear();
+  blocked.clear();
+  sprites.clear();
+}
+
+void RenderState::Draw(SDL_Renderer *sdlRenderer) const {
+  ProfileScope scope(ProfileZone::Draw);
+  for (const SpriteCopy &copy : floor)
+    SDL_RenderCopy(sdlRenderer, copy.texture, &copy.spriteRegion,
+                   &copy.drawRegion);
+  if (!blocked.empty()) {
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(sdlRenderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(sdlRenderer, 0x30, 0x30, 0x30, 0xFF);
+    SDL_RenderFillRects(sdlRenderer, blocked.data(),
+                        static_cast<int>(blocked.size()));
+    SDL_SetRenderDrawColor(sdlRenderer, r, g, b, a);
+  }
+  for (const SpriteCopy &copy : sprites)
+    SDL_RenderCopy(sdlRenderer, copy.texture, &copy.spriteRegion,
+                   &copy.drawRegion);
+}
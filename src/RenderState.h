@@ -0,0 +1,117 @@
+/*******************************************************************************
+@file `RenderState.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * `SpriteCopy`
+ *
+ *   A region of a texture to be copied onto a region of the renderer.
+ */
+struct SpriteCopy {
+  SDL_Texture *texture;
+  SDL_Rect spriteRegion;
+  SDL_Rect drawRegion;
+};
+
+/**
+ * `RenderState`
+ *
+ *   What the factory looks like at one tick, as the plain copies and fills
+ *   needed to draw it.
+ *
+ * @description
+ *   The state is captured by the simulation and drawn without reading the
+ *   factory, so it can be drawn on another thread while the factory is being
+ *   updated. The vectors keep their capacity when cleared, so capturing the
+ *   same scene again does not allocate.
+ */
+class RenderState {
+
+  /**
+   * `floor`
+   *
+   *   The floor tiles, drawn first.
+   */
+  std::vector<SpriteCopy> floor;
+
+  /**
+   * `blocked`
+   *
+   *   The blocked tiles, filled over the floor.
+   */
+  std::vector<SDL_Rect> blocked;
+
+  /**
+   * `sprites`
+   *
+   *   The machine and progress sprites, drawn last in order.
+   */
+  std::vector<SpriteCopy> sprites;
+
+public:
+  /**
+   * `Clear`
+   *
+   *   Removes everything from the state.
+   */
+  void Clear();
+
+  /**
+   * `AddFloor`
+   *
+   *   Adds a floor tile.
+   */
+  void AddFloor(SDL_Texture *texture, const SDL_Rect &spriteRegion,
+                const SDL_Rect &drawRegion) {
+    SpriteCopy copy = {texture, spriteRegion, drawRegion};
+    floor.push_back(copy);
+  }
+
+  /**
+   * `AddBlocked`
+   *
+   *   Adds a blocked tile.
+   */
+  void AddBlocked(const SDL_Rect &drawRegion) { blocked.push_back(drawRegion); }
+
+  /**
+   * `GetBlocked`
+   *
+   *   Gets the blocked tiles.
+   */
+  const std::vector<SDL_Rect> &GetBlocked() const { return blocked; }
+
+  /**
+   * `AddSprite`
+   *
+   *   Adds a sprite, drawn over everything added before it.
+   */
+  void AddSprite(SDL_Texture *texture, const SDL_Rect &spriteRegion,
+                 const SDL_Rect &drawRegion) {
+    SpriteCopy copy = {texture, spriteRegion, drawRegion};
+    sprites.push_back(copy);
+  }
+
+  /**
+   * `GetSprites`
+   *
+   *   Gets the machine and progress sprites.
+   */
+  const std::vector<SpriteCopy> &GetSprites() const { return sprites; }
+
+  /**
+   * `Draw`
+   *
+   *   Draws the state on the given renderer.
+   */
+  void Draw(SDL_Renderer *sdlRenderer) const;
+};
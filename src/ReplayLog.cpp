@@ -0,0 +1,104 @@
+/*******************************************************************************
+@file `ReplayLog.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "ReplayLog.h"
+#include <cstring>
+
+/**
+ * `REPLAY_MAGIC`
+ *
+ *   The first four bytes of a replay file.
+ */
+#define REPLAY_MAGIC "FRL1"
+
+/**
+ * `FLUSH_STEPS`
+ *
+ *   The number of recorded steps buffered before they are written.
+ */
+#define FLUSH_STEPS 4096
+
+bool ReplayLog::Record(const char *path) {
+  Close();
+  file = SDL_RWFromFile(path, "wb");
+  if (file == NULL || SDL_RWwrite(file, REPLAY_MAGIC, 4, 1) != 1) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to record replay '%s': %s\n",
+                 path, SDL_GetError());
+    Close();
+    return false;
+  }
+  steps.reserve(FLUSH_STEPS);
+  return true;
+}
+
+bool ReplayLog::Replay(const char *path) {
+  Close();
+  SDL_RWops *input = SDL_RWFromFile(path, "rb");
+  if (input == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to open replay '%s': %s\n",
+                 path, SDL_GetError());
+    return false;
+  }
+  Sint64 size = SDL_RWsize(input);
+  char magic[4];
+  bool ok = size >= 4 && SDL_RWread(input, magic, 4, 1) == 1 &&
+            std::memcmp(magic, REPLAY_MAGIC, 4) == 0;
+  if (ok) {
+    steps.resize(static_cast<std::size_t>(size - 4) / sizeof(Uint32));
+    ok = steps.empty() || SDL_RWread(input, steps.data(),
+                                     steps.size() * sizeof(Uint32), 1) == 1;
+  }
+  SDL_RWclose(input);
+  if (!ok) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to read replay '%s'\n", path);
+    steps.clear();
+    return false;
+  }
+  for (Uint32 &step : steps)
+    step = SDL_SwapLE32(step);
+  isReplaying = true;
+  return true;
+}
+
+void ReplayLog::Close() {
+  if (file != NULL) {
+    Flush();
+    SDL_RWclose(file);
+    file = NULL;
+  }
+  steps.clear();
+  position = 0;
+  isReplaying = false;
+}
+
+void ReplayLog::Write(unsigned int dt) {
+  steps.push_back(SDL_SwapLE32(static_cast<Uint32>(dt)));
+  if (steps.size() >= FLUSH_STEPS)
+    Flush();
+}
+
+bool ReplayLog::Next(unsigned int &dt) {
+  if (IsAtEnd())
+    return false;
+  dt = steps[position++];
+  return true;
+}
+
+bool ReplayLog::SkipTo(unsigned long long elapsed) {
+  unsigned long long ticks = 0;
+  position = 0;
+  while (ticks < elapsed && !IsAtEnd())
+    ticks += steps[position++];
+  return ticks == elapsed;
+}
+
+void ReplayLog::Flush() {
+  if (!steps.empty())
+    SDL_RWwrite(file, steps.data(), steps.size() * sizeof(Uint32), 1);
+  steps.clear();
+}
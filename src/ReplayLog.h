@@ -0,0 +1,136 @@
+/*******************************************************************************
+@file `ReplayLog.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * `ReplayLog`
+ *
+ *   Records the ticks of each factory update so that a run can be replayed.
+ *
+ * @description
+ *   The factory has no other input than the ticks passed to `Update`, and it
+ *   uses no randomness, so feeding the same sequence of ticks to a factory
+ *   built from the same layout reproduces the run exactly. Combined with a
+ *   snapshot, a replay can start from any checkpoint: the ticks up to the
+ *   snapshot are skipped with `SkipTo`.
+ *
+ *   The file holds a four byte magic followed by one little-endian 32-bit
+ *   tick count per update.
+ */
+class ReplayLog {
+
+  /**
+   * `file`
+   *
+   *   The file being recorded, or NULL.
+   */
+  SDL_RWops *file;
+
+  /**
+   * `steps`
+   *
+   *   The recorded ticks waiting to be written, or the ticks being replayed.
+   */
+  std::vector<Uint32> steps;
+
+  /**
+   * `position`
+   *
+   *   The index of the next step to replay.
+   */
+  std::size_t position;
+
+  /**
+   * `isReplaying`
+   *
+   *   True if the steps are being replayed; otherwise, false.
+   */
+  bool isReplaying;
+
+public:
+  ReplayLog() : file(NULL), position(0), isReplaying(false) {}
+  ~ReplayLog() { Close(); }
+
+  /**
+   * `Record`
+   *
+   *   Starts recording to the given file.
+   */
+  bool Record(const char *path);
+
+  /**
+   * `Replay`
+   *
+   *   Starts replaying the given file.
+   */
+  bool Replay(const char *path);
+
+  /**
+   * `Close`
+   *
+   *   Finishes writing the recording, or stops replaying.
+   */
+  void Close();
+
+  /**
+   * `IsRecording`
+   *
+   *   True if updates are being recorded; otherwise, false.
+   */
+  bool IsRecording() const { return file != NULL; }
+
+  /**
+   * `IsReplaying`
+   *
+   *   True if updates are being replayed; otherwise, false.
+   */
+  bool IsReplaying() const { return isReplaying; }
+
+  /**
+   * `IsAtEnd`
+   *
+   *   True if every recorded update has been replayed; otherwise, false.
+   */
+  bool IsAtEnd() const { return position >= steps.size(); }
+
+  /**
+   * `Write`
+   *
+   *   Records the ticks of an update.
+   */
+  void Write(unsigned int dt);
+
+  /**
+   * `Next`
+   *
+   *   Gets the ticks of the next recorded update.
+   *
+   * @returns
+   *   True if there was an update left to replay; otherwise, false.
+   */
+  bool Next(unsigned int &dt);
+
+  /**
+   * `SkipTo`
+   *
+   *   Skips the recorded updates up to the given number of elapsed ticks, as
+   *   when replaying from a snapshot taken at that point.
+   *
+   * @returns
+   *   True if an update ends exactly at the given ticks; otherwise, false.
+   */
+  bool SkipTo(unsigned long long elapsed);
+
+private:
+  void Flush();
+};
@@ -7,16 +7,11 @@
 *******************************************************************************/
 
 #include "RobotMachine.h"
+#include "Trace.h"
+#include <algorithm>
 
 #define HAS_TARGET_CHANGED_EVENT "RobotMachine::HasTargetChanged"
 
-static SDL_Point makePoint(int x, int y) {
-  SDL_Point p;
-  p.x = x;
-  p.y = y;
-  return p;
-}
-
 static SDL_Rect makeRect(int x, int y, int w, int h) {
   SDL_Rect r;
   r.x = x;
@@ -26,29 +21,21 @@ static SDL_Rect makeRect(int x, int y, int w, int h) {
   return r;
 }
 
-static std::vector<SDL_Point> getNeighbors(SDL_Point p) {
-  std::vector<SDL_Point> neighbors;
-  neighbors.push_back(makePoint(p.x, p.y - 1));
-  neighbors.push_back(makePoint(p.x - 1, p.y - 1));
-  neighbors.push_back(makePoint(p.x - 1, p.y));
-  neighbors.push_back(makePoint(p.x - 1, p.y + 1));
-  neighbors.push_back(makePoint(p.x, p.y + 1));
-  neighbors.push_back(makePoint(p.x + 1, p.y + 1));
-  neighbors.push_back(makePoint(p.x + 1, p.y));
-  neighbors.push_back(makePoint(p.x + 1, p.y + 1));
-  return neighbors;
-}
-
-RobotMachine::RobotMachine(SDL_Texture *spritesheet, SDL_Rect drawRegion,
-                           SDL_Point factoryPoint)
+RobotMachine::RobotMachine(
+    SDL_Texture *spritesheet, SDL_Rect drawRegion, SDL_Point factoryPoint,
+    const WalkableGrid &walkableGrid)
     : Machine(AnimatedSprite(spritesheet, makeRect(0, 48, 32, 16), drawRegion,
                              16, 16, 2, 100),
               factoryPoint, 1000),
       _pickTarget(new PickTargetAlgorithm(
           [this](std::pair<StructureMachine *, std::vector<SDL_Point>>
                      &targetPath) { this->SetTargetPath(targetPath); },
-          &getNeighbors)),
+          [this](std::vector<SDL_Point> &path) {
+            this->SetProvisionalPath(path);
+          },
+          walkableGrid)),
       _stepDelay(100), _stepTick(0), _isEmpty(true), _isPickingTarget(false),
+      _isPlanningNextLeg(false), _isDeferringEvents(false),
       _emptySpriteRegion(makeRect(0, 48, 32, 16)),
       _fullSpriteRegion(makeRect(0, 64, 32, 16)), _target(NULL) {
   EventEmitter<RobotMachine>::AddEvent(HAS_TARGET_CHANGED_EVENT);
@@ -67,18 +54,119 @@ void RobotMachine::AddHasTargetChangedEventHandler(
 
 void RobotMachine::PickTarget(std::list<StructureMachine *> candidates) {
   _isPickingTarget = true;
+  _isPlanningNextLeg = false;
+  _nextLeg.first = NULL;
+  _nextLeg.second.clear();
+  _trail.clear();
   _pickTarget->Begin(GetFactoryPoint(), candidates);
 }
 
+void RobotMachine::PlanNextLeg(std::list<StructureMachine *> candidates) {
+  if (_target == NULL)
+    return;
+  _isPickingTarget = true;
+  _isPlanningNextLeg = true;
+  _nextLeg.first = NULL;
+  _nextLeg.second.clear();
+  _trail.clear();
+  // The search may be over at once, or never start without candidates.
+  if (!_pickTarget->Begin(_target->GetFactoryPoint(), candidates))
+    _isPickingTarget = false;
+}
+
+void RobotMachine::TakeNextLeg() {
+  _isPlanningNextLeg = false;
+  if (_isPickingTarget)
+    return;
+  if (_nextLeg.first == NULL) {
+    OnHasTargetChanged();
+    return;
+  }
+  std::pair<StructureMachine *, std::vector<SDL_Point>> nextLeg;
+  nextLeg.swap(_nextLeg);
+  SetTargetPath(nextLeg);
+}
+
+void RobotMachine::AssignTarget(StructureMachine *target,
+                                std::vector<SDL_Point> &path) {
+  std::pair<StructureMachine *, std::vector<SDL_Point>> targetPath(target,
+                                                                   path);
+  SetTargetPath(targetPath);
+}
+
+void RobotMachine::Save(Snapshot &snapshot) const {
+  Machine::Save(snapshot);
+  snapshot.Write(_stepTick);
+  snapshot.Write(_isEmpty);
+  snapshot.Write(_isPickingTarget);
+  snapshot.Write(_isPlanningNextLeg);
+  snapshot.WriteVector(_path);
+  snapshot.WriteVector(_trail);
+  snapshot.WriteMachine(_target);
+  snapshot.WriteMachine(_nextLeg.first);
+  snapshot.WriteVector(_nextLeg.second);
+  _pickTarget->Save(snapshot);
+}
+
+void RobotMachine::Restore(Snapshot &snapshot) {
+  Machine::Restore(snapshot);
+  snapshot.Read(_stepTick);
+  snapshot.Read(_isEmpty);
+  snapshot.Read(_isPickingTarget);
+  snapshot.Read(_isPlanningNextLeg);
+  snapshot.ReadVector(_path);
+  snapshot.ReadVector(_trail);
+  _target = static_cast<StructureMachine *>(snapshot.ReadMachine());
+  _nextLeg.first = static_cast<StructureMachine *>(snapshot.ReadMachine());
+  snapshot.ReadVector(_nextLeg.second);
+  _pickTarget->Restore(snapshot);
+  GetMachineSprite().SetFramesRegion(_isEmpty ? _emptySpriteRegion
+                                              : _fullSpriteRegion);
+}
+
+void RobotMachine::Advance(unsigned int tick) {
+  _isDeferringEvents = true;
+  UpdateTo(tick);
+  _isDeferringEvents = false;
+}
+
+void RobotMachine::CommitEvents() {
+  // Handlers run with deferral off, so nothing is queued while committing.
+  for (DeferredEvent event : _deferredEvents) {
+    if (event == DeferredEvent::IsIdleChanged)
+      Machine::OnIsIdleChanged();
+    else
+      OnHasTargetChanged();
+  }
+  _deferredEvents.clear();
+}
+
+void RobotMachine::OnIsIdleChanged() {
+  if (_isDeferringEvents)
+    _deferredEvents.push_back(DeferredEvent::IsIdleChanged);
+  else
+    Machine::OnIsIdleChanged();
+}
+
 void RobotMachine::OnHasTargetChanged() {
+  if (_isDeferringEvents) {
+    _deferredEvents.push_back(DeferredEvent::HasTargetChanged);
+    return;
+  }
+  if (Trace::IsEnabled())
+    Trace::Instant(HAS_TARGET_CHANGED_EVENT, this, HasTarget());
   EventPayload<RobotMachine> payload(this);
   EventEmitter<RobotMachine>::EmitEvent(HAS_TARGET_CHANGED_EVENT, payload);
 }
 
 void RobotMachine::OnUpdate(unsigned int dt) {
+  GetMetrics().idleTicks += _path.empty() && _target == NULL ? dt : 0;
   _stepTick = _path.empty() ? 0 : _stepTick + dt;
   if (_stepTick >= _stepDelay) {
     _stepTick -= _stepDelay;
+    GetMetrics().steps++;
+    if (!_trail.empty())
+      _trail.push_back(_path.back());
     SetFactoryPoint(_path.back());
     _path.pop_back();
     if (_path.empty() && _target != NULL && _target->IsIdle()) {
@@ -99,21 +187,76 @@ void RobotMachine::OnUpdate(unsigned int dt) {
 void RobotMachine::SetTargetPath(
     std::pair<StructureMachine *, std::vector<SDL_Point>> &targetPath) {
   _isPickingTarget = false;
+  if (_isPlanningNextLeg) {
+    // The next leg waits until the robot is done with its current target.
+    _nextLeg = targetPath;
+    return;
+  }
   _target = targetPath.first;
-  _path = targetPath.second;
+  if (_trail.empty())
+    _path = targetPath.second;
+  else if (_target == NULL)
+    _path.clear();
+  else
+    FollowPath(targetPath.second);
+  _trail.clear();
   OnHasTargetChanged();
 }
 
+void RobotMachine::SetProvisionalPath(std::vector<SDL_Point> &path) {
+  // The robot is already walking to its current target, or the final path
+  // was already given.
+  if (_isPlanningNextLeg || !_isPickingTarget)
+    return;
+  // The robot has not moved since the search began until it has a trail.
+  if (_trail.empty())
+    _trail.push_back(GetFactoryPoint());
+  FollowPath(path);
+}
+
+void RobotMachine::FollowPath(const std::vector<SDL_Point> &path) {
+  SDL_Point step = GetStep();
+  auto isAt = [](const SDL_Point &a, const SDL_Point &b) {
+    return a.x == b.x && a.y == b.y;
+  };
+
+  // The path ends at the origin, which is the first point of the trail, so
+  // the latest point of the trail on the path is always found.
+  std::size_t m = _trail.size();
+  auto junction = path.end();
+  while (junction == path.end() && m > 0) {
+    m--;
+    junction = std::find_if(
+        path.begin(), path.end(),
+        [this, m, &isAt](const SDL_Point &p) { return isAt(p, _trail[m]); });
+  }
+  _path.assign(path.begin(), junction);
+  _path.insert(_path.end(), _trail.begin() + m, _trail.end());
+
+  // The point the robot stands on is only stepped on when it is the goal.
+  if (_path.size() > 1)
+    _path.pop_back();
+  if (_path.empty() || !isAt(_path.back(), step))
+    _stepTick = 0;
+}
+
 void RobotMachine::IsIdleChanged(EventPayload<Machine> &) {
   if (IsIdle()) {
     SDL_Point targetPoint = _target->GetFactoryPoint();
     SDL_Point thisPoint = GetFactoryPoint();
-    if (targetPoint.x == thisPoint.x && targetPoint.y == thisPoint.y)
+    // The station is not updated while it is idle, so it starts working at
+    // the tick of the robot.
+    if (targetPoint.x == thisPoint.x && targetPoint.y == thisPoint.y) {
+      _target->SetUpdateTick(GetUpdateTick());
       _target->Restart();
+    }
     _target = NULL;
     _isEmpty = !_isEmpty;
     GetMachineSprite().SetFramesRegion(_isEmpty ? _emptySpriteRegion
                                                 : _fullSpriteRegion);
-    OnHasTargetChanged();
+    if (_isPlanningNextLeg)
+      TakeNextLeg();
+    else
+      OnHasTargetChanged();
   }
 }
\ No newline at end of file
@@ -24,6 +24,13 @@
  */
 class RobotMachine : public Machine, private EventEmitter<RobotMachine> {
 
+  /**
+   * `DeferredEvent`
+   *
+   *   An event raised while the robot was advancing.
+   */
+  enum class DeferredEvent : char { IsIdleChanged, HasTargetChanged };
+
   /**
    * `_stepDelay`
    *
@@ -52,6 +59,28 @@ class RobotMachine : public Machine, private EventEmitter<RobotMachine> {
    */
   bool _isPickingTarget;
 
+  /**
+   * `_isPlanningNextLeg`
+   *
+   *   Whether or not the target search in progress, or its result, is for the
+   *   leg after the current target.
+   */
+  bool _isPlanningNextLeg;
+
+  /**
+   * `_isDeferringEvents`
+   *
+   *   Whether or not events are queued instead of emitted.
+   */
+  bool _isDeferringEvents;
+
+  /**
+   * `_deferredEvents`
+   *
+   *   The events raised while advancing, in the order they were raised.
+   */
+  std::vector<DeferredEvent> _deferredEvents;
+
   /**
    * `_emptySpriteRegion`
    *
@@ -73,6 +102,14 @@ class RobotMachine : public Machine, private EventEmitter<RobotMachine> {
    */
   std::vector<SDL_Point> _path;
 
+  /**
+   * `_trail`
+   *
+   *   The points the robot has stepped on since it began to follow a
+   *   provisional path, starting with the origin of the target search.
+   */
+  std::vector<SDL_Point> _trail;
+
   /**
    * `_target`
    *
@@ -80,6 +117,14 @@ class RobotMachine : public Machine, private EventEmitter<RobotMachine> {
    */
   StructureMachine *_target;
 
+  /**
+   * `_nextLeg`
+   *
+   *   The target picked for the leg after the current target, with the path
+   *   from the current target to it.
+   */
+  std::pair<StructureMachine *, std::vector<SDL_Point>> _nextLeg;
+
   /**
    * `_pickTarget`
    *
@@ -101,9 +146,12 @@ public:
    *
    * @param factoryPoint
    *   The factory coordinates of the machine.
+   *
+   * @param walkableGrid
+   *   The walkable tiles of the factory.
    */
   RobotMachine(SDL_Texture *spritesheet, SDL_Rect drawRegion,
-               SDL_Point factoryPoint);
+               SDL_Point factoryPoint, const WalkableGrid &walkableGrid);
 
   /**
    * `~RobotMachine`
@@ -120,6 +168,26 @@ public:
   void AddHasTargetChangedEventHandler(
       std::function<void(EventPayload<RobotMachine> &)> handler);
 
+  /**
+   * `Advance`
+   *
+   *   Updates the robot to the given factory tick without emitting events.
+   *
+   * @description
+   *   Advancing only changes the robot itself: its timers, its position along
+   *   its path and its target search. Events that would change the factory or
+   *   other machines are queued until `CommitEvents`, so different robots can
+   *   be advanced on different threads at the same time.
+   */
+  void Advance(unsigned int tick);
+
+  /**
+   * `CommitEvents`
+   *
+   *   Emits the events queued by `Advance` in the order they were raised.
+   */
+  void CommitEvents();
+
   /**
    * `PickTarget`
    *
@@ -130,11 +198,93 @@ public:
    *   The shortest path is calculated for each candidate. The candidate with
    *   the shortest path is chosen as the target.
    *
-   *   It is recommended that the factory recall this method if the collection
-   *   of candidates changes.
+   *   If the collection of candidates changes while the search is in progress,
+   *   the factory should call `AddCandidate` or `RemoveCandidate` rather than
+   *   start over.
    */
   void PickTarget(std::list<StructureMachine *> candidates);
 
+  /**
+   * `PlanNextLeg`
+   *
+   *   Selects the target after the current one from a collection of candidate
+   *   structure machines while the robot travels to and works at its current
+   *   target.
+   *
+   * @description
+   *   Paths are searched from the current target. The picked target is kept
+   *   aside and becomes the robot's target, announced with `HasTargetChanged`,
+   *   once the robot is done with its current one. A search not finished by
+   *   then carries on as the robot's own search.
+   */
+  void PlanNextLeg(std::list<StructureMachine *> candidates);
+
+  /**
+   * `SetAnytimeBudget`
+   *
+   *   Sets the number of search iterations after which the robot starts to
+   *   walk a provisional path instead of waiting for its target. Zero makes
+   *   the robot wait. See `PickTargetAlgorithm::SetAnytimeBudget`.
+   */
+  void SetAnytimeBudget(unsigned int value) {
+    _pickTarget->SetAnytimeBudget(value);
+  }
+
+  /**
+   * `AddCandidate`
+   *
+   *   Adds a candidate to the target search in progress, if any.
+   */
+  void AddCandidate(StructureMachine *candidate) {
+    _pickTarget->AddCandidate(candidate);
+  }
+
+  /**
+   * `RemoveCandidate`
+   *
+   *   Removes a candidate from the target search in progress, if any, keeping
+   *   the progress made on the other candidates.
+   */
+  void RemoveCandidate(StructureMachine *candidate) {
+    _pickTarget->RemoveCandidate(candidate);
+  }
+
+  /**
+   * `AssignTarget`
+   *
+   *   Sets the target of the robot and the path towards it without searching.
+   *
+   * @description
+   *   Used by the factory when targets are assigned to several robots at once.
+   */
+  void AssignTarget(StructureMachine *target, std::vector<SDL_Point> &path);
+
+  /**
+   * `Save`
+   *
+   *   Writes the simulation state of the robot, including any search in
+   *   progress, to a snapshot.
+   */
+  void Save(Snapshot &snapshot) const;
+
+  /**
+   * `Restore`
+   *
+   *   Reads the simulation state of the robot from a snapshot.
+   */
+  void Restore(Snapshot &snapshot);
+
+  /**
+   * `ClearTarget`
+   *
+   *   Drops the target and the path towards it without emitting events.
+   */
+  void ClearTarget() {
+    _target = NULL;
+    _path.clear();
+    _trail.clear();
+  }
+
   /**
    * `GetTarget`
    *
@@ -163,6 +313,35 @@ public:
    */
   bool IsPickingTarget() { return _isPickingTarget; }
 
+  /**
+   * `IsPlanningNextLeg`
+   *
+   *   True if the target search in progress, or its result, is for the leg
+   *   after the current target; otherwise, false.
+   */
+  bool IsPlanningNextLeg() { return _isPlanningNextLeg; }
+
+  /**
+   * `GetNextTarget`
+   *
+   *   Gets the target picked for the leg after the current target, if any.
+   */
+  StructureMachine *GetNextTarget() { return _nextLeg.first; }
+
+  /**
+   * `IsPickingProducers`
+   *
+   *   True if the target being searched for is a producer; otherwise, false.
+   */
+  bool IsPickingProducers() { return _isEmpty != _isPlanningNextLeg; }
+
+  /**
+   * `GetSearchOpenSetSize`
+   *
+   *   Gets the number of points in the open set of the current path search.
+   */
+  std::size_t GetSearchOpenSetSize() { return _pickTarget->GetOpenSetSize(); }
+
   /**
    * `GetStepProgress`
    *
@@ -190,6 +369,13 @@ protected:
    */
   virtual void OnHasTargetChanged();
 
+  /**
+   * `OnIsIdleChanged`
+   *
+   *   Event when the machine changes from busy to idle.
+   */
+  void OnIsIdleChanged();
+
   /**
    * `OnUpdate`
    *
@@ -206,6 +392,28 @@ private:
   void SetTargetPath(
       std::pair<StructureMachine *, std::vector<SDL_Point>> &targetPath);
 
+  /**
+   * `SetProvisionalPath`
+   *
+   *   Callback for a provisional path from the pick target algorithm.
+   */
+  void SetProvisionalPath(std::vector<SDL_Point> &path);
+
+  /**
+   * `FollowPath`
+   *
+   *   Replaces the path of the robot with a path from the origin of the target
+   *   search, walking back along the trail to where the two meet.
+   */
+  void FollowPath(const std::vector<SDL_Point> &path);
+
+  /**
+   * `TakeNextLeg`
+   *
+   *   Makes the planned next leg, if any, the current one.
+   */
+  void TakeNextLeg();
+
   /**
    * `IsIdleChanged`
    *
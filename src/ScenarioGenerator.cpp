@@ -0,0 +1,177 @@
+/*******************************************************************************
+@file `ScenarioGenerator.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "ScenarioGenerator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * `PLACEMENT_ATTEMPTS`
+ *
+ *   The number of random tiles tried before falling back to a linear scan.
+ */
+#define PLACEMENT_ATTEMPTS 64
+
+/**
+ * `CLUSTER_COUNT`
+ *
+ *   The number of cluster centers of each station kind.
+ */
+#define CLUSTER_COUNT 4
+
+static SDL_Point makePoint(int x, int y) {
+  SDL_Point p;
+  p.x = x;
+  p.y = y;
+  return p;
+}
+
+bool ScenarioGenerator::Parse(const char *spec) {
+  std::string copy(spec);
+  for (char *pair = std::strtok(&copy[0], ","); pair != NULL;
+       pair = std::strtok(NULL, ",")) {
+    char *value = std::strchr(pair, '=');
+    if (value == NULL)
+      return false;
+    *value++ = '\0';
+    if (std::strcmp(pair, "width") == 0)
+      width = std::atoi(value);
+    else if (std::strcmp(pair, "height") == 0)
+      height = std::atoi(value);
+    else if (std::strcmp(pair, "consumers") == 0)
+      consumers = std::atoi(value);
+    else if (std::strcmp(pair, "producers") == 0)
+      producers = std::atoi(value);
+    else if (std::strcmp(pair, "robots") == 0)
+      robots = std::atoi(value);
+    else if (std::strcmp(pair, "obstacles") == 0)
+      obstacles = std::atof(value);
+    else if (std::strcmp(pair, "busy") == 0)
+      busyDelay = std::strtoul(value, NULL, 10);
+    else if (std::strcmp(pair, "seed") == 0)
+      seed = std::strtoul(value, NULL, 10);
+    else if (std::strcmp(pair, "distribution") == 0 &&
+             std::strcmp(value, "uniform") == 0)
+      distribution = Distribution::Uniform;
+    else if (std::strcmp(pair, "distribution") == 0 &&
+             std::strcmp(value, "rows") == 0)
+      distribution = Distribution::Rows;
+    else if (std::strcmp(pair, "distribution") == 0 &&
+             std::strcmp(value, "clusters") == 0)
+      distribution = Distribution::Clusters;
+    else {
+      SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unknown scenario parameter: %s\n",
+                   pair);
+      return false;
+    }
+  }
+  return width > 0 && height > 0;
+}
+
+void ScenarioGenerator::Generate(FactoryLayout &layout) {
+  random.seed(seed);
+  layout.Resize(width, height);
+  layout.consumers.clear();
+  layout.producers.clear();
+  layout.robots.clear();
+  occupied.assign(layout.blocked.size(), 0);
+
+  // Rows of stations are kept clear of obstacles so that they stay reachable.
+  std::bernoulli_distribution isBlocked(obstacles);
+  for (int y = 0; y < height; y++) {
+    bool isStationRow = distribution == Distribution::Rows &&
+                        (y <= 1 || y >= height - 2);
+    for (int x = 0; x < width; x++) {
+      if (!isStationRow && isBlocked(random)) {
+        layout.blocked[y * width + x] = 1;
+        occupied[y * width + x] = 1;
+      }
+    }
+  }
+
+  AddStations(layout.consumers, consumers, 0);
+  AddStations(layout.producers, producers, height - 2);
+
+  // Robots may share tiles with each other, but not with obstacles.
+  std::uniform_int_distribution<int> randomX(0, width - 1);
+  std::uniform_int_distribution<int> randomY(0, height - 1);
+  layout.robots.reserve(robots);
+  for (int i = 0; i < robots; i++) {
+    SDL_Point p = makePoint(randomX(random), randomY(random));
+    for (int n = 0; n < PLACEMENT_ATTEMPTS && layout.blocked[p.y * width + p.x];
+         n++)
+      p = makePoint(randomX(random), randomY(random));
+    if (!layout.blocked[p.y * width + p.x])
+      layout.robots.push_back(p);
+  }
+}
+
+void ScenarioGenerator::AddStations(
+    std::vector<FactoryLayout::Station> &stations, int count, int row) {
+  std::uniform_int_distribution<int> randomX(0, width - 1);
+  std::uniform_int_distribution<int> randomY(0, height - 1);
+  SDL_Point centers[CLUSTER_COUNT];
+  for (SDL_Point &center : centers)
+    center = makePoint(randomX(random), randomY(random));
+  int spread = 1 + (width < height ? width : height) / 8;
+
+  stations.reserve(count);
+  for (int i = 0; i < count; i++) {
+    SDL_Point center;
+    switch (distribution) {
+    case Distribution::Rows:
+      // Spread evenly along the row, as in the demo factory.
+      center = makePoint((2 * i + 1) * width / (2 * count), row);
+      break;
+    case Distribution::Clusters:
+      center = centers[i % CLUSTER_COUNT];
+      break;
+    default:
+      center = makePoint(randomX(random), randomY(random));
+      break;
+    }
+    FactoryLayout::Station station;
+    station.busyDelay = busyDelay;
+    if (!PlaceStation(center,
+                      distribution == Distribution::Uniform ? 0 : spread,
+                      station.point))
+      return;
+    stations.push_back(station);
+  }
+}
+
+bool ScenarioGenerator::PlaceStation(SDL_Point center, int spread,
+                                     SDL_Point &result) {
+  std::uniform_int_distribution<int> offset(-spread, spread);
+  for (int n = 0; n < PLACEMENT_ATTEMPTS; n++) {
+    int x = center.x + (n == 0 ? 0 : offset(random));
+    int y = center.y + (n == 0 ? 0 : offset(random));
+    if (x >= 0 && y >= 0 && x < width && y < height &&
+        !occupied[y * width + x]) {
+      occupied[y * width + x] = 1;
+      result = makePoint(x, y);
+      return true;
+    }
+  }
+  result = PickFreeTile();
+  return result.x >= 0;
+}
+
+SDL_Point ScenarioGenerator::PickFreeTile() {
+  std::uniform_int_distribution<int> randomTile(0, width * height - 1);
+  int start = randomTile(random);
+  for (int n = 0; n < width * height; n++) {
+    int i = (start + n) % (width * height);
+    if (!occupied[i]) {
+      occupied[i] = 1;
+      return makePoint(i % width, i / width);
+    }
+  }
+  return makePoint(-1, -1);
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+@file `ScenarioGenerator.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include "FactoryLayout.h"
+#include <random>
+#include <vector>
+
+/**
+ * `ScenarioGenerator`
+ *
+ *   Generates factory layouts from a handful of parameters for stress testing.
+ *
+ * @description
+ *   The same parameters and seed always produce the same layout. Parameters
+ *   are given as a comma separated list of `name=value` pairs, for example
+ *   `width=256,height=256,robots=1000,obstacles=0.1,seed=7`:
+ *
+ *     width, height          The size of the factory in tiles.
+ *     consumers, producers   The number of stations of each kind.
+ *     robots                 The number of robots.
+ *     obstacles              The fraction of tiles that are blocked.
+ *     busy                   The busy delay of the stations.
+ *     distribution           How stations are placed: `uniform` anywhere,
+ *                            `rows` along the top and bottom rows as in the
+ *                            demo, or `clusters` around a few random centers.
+ *     seed                   The random seed.
+ */
+class ScenarioGenerator {
+public:
+  /**
+   * `Distribution`
+   *
+   *   How stations are placed in the factory.
+   */
+  enum class Distribution { Uniform, Rows, Clusters };
+
+  int width;
+  int height;
+  int consumers;
+  int producers;
+  int robots;
+  double obstacles;
+  unsigned int busyDelay;
+  Distribution distribution;
+  unsigned int seed;
+
+  ScenarioGenerator()
+      : width(15), height(11), consumers(5), producers(5), robots(3),
+        obstacles(0.0), busyDelay(5000), distribution(Distribution::Rows),
+        seed(1) {}
+
+  /**
+   * `Parse`
+   *
+   *   Sets the parameters from a comma separated list of `name=value` pairs.
+   *
+   * @returns
+   *   True if every pair was recognized; otherwise, false.
+   */
+  bool Parse(const char *spec);
+
+  /**
+   * `Generate`
+   *
+   *   Generates a layout from the parameters.
+   */
+  void Generate(FactoryLayout &layout);
+
+private:
+  /**
+   * `random`
+   *
+   *   The random number generator of the current layout.
+   */
+  std::mt19937 random;
+
+  /**
+   * `occupied`
+   *
+   *   Nonzero for each tile that is blocked or holds a station.
+   */
+  std::vector<char> occupied;
+
+  bool PlaceStation(SDL_Point center, int spread, SDL_Point &result);
+  SDL_Point PickFreeTile();
+  void AddStations(std::vector<FactoryLayout::Station> &stations, int count,
+                   int row);
+};
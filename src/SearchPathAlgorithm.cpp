@@ -8,117 +8,194 @@
 
 #include "SearchPathAlgorithm.h"
 
-std::size_t SearchPathAlgorithm::SDL_PointHash::
-operator()(const SDL_Point value) const {
-  std::size_t result = static_cast<std::size_t>(value.x);
-  result *= 2654435761U;
-  return result ^ static_cast<std::size_t>(value.y);
+const int FourWayNeighborhood::Offsets[FourWayNeighborhood::Count][2] = {
+    {0, -1}, {-1, 0}, {0, 1}, {1, 0}};
+
+const int EightWayNeighborhood::Offsets[EightWayNeighborhood::Count][2] = {
+    {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}};
+
+template <class N, class H>
+BasicSearchPathAlgorithm<N, H>::BasicSearchPathAlgorithm(
+    std::function<void(std::vector<SDL_Point> &)> resultCallback,
+    const WalkableGrid &walkableGrid)
+    : IterativeAlgorithm<std::vector<SDL_Point>, SDL_Point, SDL_Point>(
+          resultCallback),
+      step(Step::Done), grid(walkableGrid) {}
+
+template <class S> static void savePoints(Snapshot &snapshot, const S &points) {
+  snapshot.Write(static_cast<Uint64>(points.size()));
+  for (const SDL_Point &p : points)
+    snapshot.Write(p);
 }
 
-bool SearchPathAlgorithm::SDL_PointCompare::
-operator()(const SDL_Point lhs, const SDL_Point rhs) const {
-  return owner.CalcFScore(lhs) > owner.CalcFScore(rhs);
+template <class S> static void restorePoints(Snapshot &snapshot, S &points) {
+  std::size_t count = snapshot.ReadCount(sizeof(SDL_Point));
+  points.clear();
+  points.reserve(count);
+  for (std::size_t n = 0; n < count; n++) {
+    SDL_Point p;
+    snapshot.Read(p);
+    points.insert(p);
+  }
 }
 
-bool SearchPathAlgorithm::SDL_PointEqual::
-operator()(const SDL_Point lhs, const SDL_Point rhs) const {
-  return lhs.x == rhs.x && lhs.y == rhs.y;
+template <class M> static void saveMap(Snapshot &snapshot, const M &map) {
+  snapshot.Write(static_cast<Uint64>(map.size()));
+  for (const auto &entry : map) {
+    snapshot.Write(entry.first);
+    snapshot.Write(entry.second);
+  }
 }
 
-SearchPathAlgorithm::SearchPathAlgorithm(
-    std::function<void(std::vector<SDL_Point> &)> resultCallback,
-    std::function<std::vector<SDL_Point>(SDL_Point)> getNeighborsFn)
-    : IterativeAlgorithm<std::vector<SDL_Point>, SDL_Point, SDL_Point>(
-          resultCallback),
-      getNeighbors(getNeighborsFn), nextFn(&loops[0]), openQueue(*this) {
-  loops[0] = [this]() { return false; };
-  loops[1] = [this]() {
-    if (openQueue.empty()) {
-      result.clear();
-      nextFn = &loops[0];
-      Return(result);
-      return (*nextFn)();
-    }
-    current = openQueue.top();
-    if (SDL_PointEqual()(current, argGoal)) {
-      result.clear();
-      result.push_back(current);
-      nextFn = &loops[3];
-      return (*nextFn)();
-    }
-    openQueue.pop();
-    openSet.erase(current);
-    closedSet.insert(current);
-    neighbors = getNeighbors(current);
-    if (neighbors.empty())
-      return true;
-    i = 0;
-    nextFn = &loops[2];
-    return (*nextFn)();
-  };
-  loops[2] = [this]() {
-    if (i >= neighbors.size()) {
-      nextFn = &loops[1];
-      return true;
-    }
-    SDL_Point &neighbor = neighbors[i];
-    auto search = closedSet.find(neighbor);
-    if (search != closedSet.end()) {
-      i++;
-      return true;
-    }
-    if (openSet.insert(neighbor).second)
-      openQueue.push(neighbor);
-    // Assume there is a gScore for current.
-    int score = gScore[current] + CalcDist(current, neighbor);
-    auto gScoreNeighbor = gScore.find(neighbor);
-    if (gScoreNeighbor != gScore.end() && gScoreNeighbor->second < score) {
-      i++;
-      return true;
-    }
-    cameFrom[neighbor] = current;
-    gScore[neighbor] = score;
-    fScore[neighbor] = CalcFScore(neighbor);
-    i++;
-    return true;
-  };
-  loops[3] = [this]() {
-    auto search = cameFrom.find(current);
-    if (search != cameFrom.end()) {
-      current = search->second;
-      result.push_back(current);
-      search = cameFrom.find(current);
-      return true;
-    }
-    nextFn = &loops[0];
-    Return(result);
-    return (*nextFn)();
-  };
+template <class M> static void restoreMap(Snapshot &snapshot, M &map) {
+  std::size_t count =
+      snapshot.ReadCount(sizeof(SDL_Point) + sizeof(typename M::mapped_type));
+  map.clear();
+  map.reserve(count);
+  for (std::size_t n = 0; n < count; n++) {
+    SDL_Point key;
+    typename M::mapped_type value;
+    snapshot.Read(key);
+    snapshot.Read(value);
+    map[key] = value;
+  }
 }
 
-int SearchPathAlgorithm::CalcFScore(const SDL_Point p) const {
-  return CalcDist(p, argGoal);
+template <class N, class H>
+void BasicSearchPathAlgorithm<N, H>::Save(Snapshot &snapshot) const {
+  snapshot.Write(step);
+  if (step == Step::Done)
+    return;
+  snapshot.Write(argStart);
+  snapshot.Write(argGoal);
+  snapshot.Write(current);
+  // The heap is saved in its array order so that ties pop in the same order.
+  snapshot.WriteVector(openQueue.container());
+  savePoints(snapshot, closedSet);
+  saveMap(snapshot, cameFrom);
+  saveMap(snapshot, gScore);
+  snapshot.WriteVector(result);
 }
 
-int SearchPathAlgorithm::CalcDist(const SDL_Point a, const SDL_Point b) const {
-  int x = a.x - b.x;
-  int y = a.y - b.y;
-  return x * x + y * y;
+template <class N, class H>
+void BasicSearchPathAlgorithm<N, H>::Restore(Snapshot &snapshot) {
+  snapshot.Read(step);
+  if (step == Step::Done) {
+    openQueue.clear();
+    closedSet.clear();
+    cameFrom.clear();
+    gScore.clear();
+    return;
+  }
+  snapshot.Read(argStart);
+  snapshot.Read(argGoal);
+  snapshot.Read(current);
+  snapshot.ReadVector(openQueue.container());
+  restorePoints(snapshot, closedSet);
+  restoreMap(snapshot, cameFrom);
+  restoreMap(snapshot, gScore);
+  snapshot.ReadVector(result);
 }
 
-bool SearchPathAlgorithm::Begin(SDL_Point start, SDL_Point goal) {
+template <class N, class H>
+bool BasicSearchPathAlgorithm<N, H>::Begin(SDL_Point start, SDL_Point goal) {
   argStart = start;
   argGoal = goal;
   openQueue.clear();
-  openSet.clear();
   closedSet.clear();
   cameFrom.clear();
   gScore.clear();
-  fScore.clear();
-  openQueue.push(argStart);
-  openSet.insert(argStart);
+  if (!grid.IsConnected(argStart, argGoal)) {
+    result.clear();
+    return Finish();
+  }
+  OpenEntry entry = {argStart, CalcHScore(argStart, argGoal), 0};
+  openQueue.push(entry);
   gScore[argStart] = 0;
-  fScore[argStart] = CalcFScore(argStart);
-  nextFn = &loops[1];
-  return (*nextFn)();
+  return Expand();
+}
+
+template <class N, class H> bool BasicSearchPathAlgorithm<N, H>::Finish() {
+  step = Step::Done;
+  Return(result);
+  // The result callback may have begun a new search.
+  return step != Step::Done;
+}
+
+template <class N, class H>
+void BasicSearchPathAlgorithm<N, H>::GetPartialPath(
+    std::vector<SDL_Point> &path) const {
+  path.clear();
+  if (step != Step::Expand || openQueue.empty())
+    return;
+  // A stale entry at the top was expanded already, so its path is still known.
+  path.push_back(openQueue.top().point);
+  for (auto search = cameFrom.find(path.back()); search != cameFrom.end();
+       search = cameFrom.find(path.back()))
+    path.push_back(search->second);
+}
+
+template <class N, class H>
+unsigned int BasicSearchPathAlgorithm<N, H>::GetMinSteps() const {
+  if (step != Step::Expand || openQueue.empty())
+    return 0;
+  // No step costs more than the most expensive one.
+  return (openQueue.top().fScore + N::MaxCost - 1) / N::MaxCost;
 }
+
+template <class N, class H> bool BasicSearchPathAlgorithm<N, H>::Expand() {
+  // Skip the entries of points that were reached again at a lower cost and
+  // have since been expanded.
+  while (!openQueue.empty() && closedSet.count(openQueue.top().point) > 0)
+    openQueue.pop();
+  if (openQueue.empty()) {
+    result.clear();
+    return Finish();
+  }
+  OpenEntry entry = openQueue.top();
+  current = entry.point;
+  if (SDL_PointEqual()(current, argGoal)) {
+    result.clear();
+    result.push_back(current);
+    step = Step::Reconstruct;
+    return Reconstruct();
+  }
+  openQueue.pop();
+  closedSet.insert(current);
+  // The neighborhood is known at compile time, so all neighbors are visited
+  // in the same iteration.
+  for (int i = 0; i < N::Count; i++) {
+    SDL_Point neighbor;
+    neighbor.x = current.x + N::Offsets[i][0];
+    neighbor.y = current.y + N::Offsets[i][1];
+    if (!grid.IsWalkable(neighbor) || closedSet.count(neighbor) > 0)
+      continue;
+    unsigned int score =
+        entry.gScore + N::Cost(N::Offsets[i][0], N::Offsets[i][1]);
+    auto gScoreNeighbor = gScore.find(neighbor);
+    if (gScoreNeighbor != gScore.end() && gScoreNeighbor->second <= score)
+      continue;
+    cameFrom[neighbor] = current;
+    gScore[neighbor] = score;
+    OpenEntry next = {neighbor, score + CalcHScore(neighbor, argGoal), score};
+    openQueue.push(next);
+  }
+  step = Step::Expand;
+  return true;
+}
+
+template <class N, class H> bool BasicSearchPathAlgorithm<N, H>::Reconstruct() {
+  auto search = cameFrom.find(current);
+  if (search != cameFrom.end()) {
+    current = search->second;
+    result.push_back(current);
+    return true;
+  }
+  return Finish();
+}
+
+template class BasicSearchPathAlgorithm<FourWayNeighborhood,
+                                        ManhattanHeuristic>;
+template class BasicSearchPathAlgorithm<EightWayNeighborhood, OctileHeuristic>;
+template class BasicSearchPathAlgorithm<EightWayNeighborhood,
+                                        ChebyshevHeuristic>;
@@ -8,8 +8,12 @@
 
 #pragma once
 
+#include "ComponentGrid.h"
 #include "IterativeAlgorithm.h"
+#include "Profiler.h"
+#include "Snapshot.h"
 #include <SDL2/SDL.h>
+#include <cstddef>
 #include <functional>
 #include <queue>
 #include <unordered_map>
@@ -17,104 +21,274 @@
 #include <vector>
 
 /**
- * `SearchPathAlgorithm`
+ * `PATH_STRAIGHT_COST`
+ *
+ *   The fixed-point cost of a step to a side neighbor.
+ */
+#define PATH_STRAIGHT_COST 1000u
+
+/**
+ * `PATH_DIAGONAL_COST`
+ *
+ *   The fixed-point cost of a step to a diagonal neighbor, the straight cost
+ *   times the square root of 2 rounded down so that the octile heuristic never
+ *   overestimates.
+ */
+#define PATH_DIAGONAL_COST 1414u
+
+/**
+ * `WalkableGrid`
+ *
+ *   A view of the walkable tiles of a map for path searches.
+ */
+class WalkableGrid {
+
+  /**
+   * `size`
+   *
+   *   The width and height of the map in tiles.
+   */
+  SDL_Point size;
+
+  /**
+   * `blocked`
+   *
+   *   Nonzero for each blocked tile, row by row.
+   */
+  const std::vector<char> *blocked;
+
+  /**
+   * `components`
+   *
+   *   The connected components of the walkable tiles, or null if unknown.
+   */
+  const ComponentGrid *components;
+
+public:
+  /**
+   * `WalkableGrid`
+   *
+   *   Constructor. The grid refers to the blocked tiles and, optionally, their
+   *   connected components, which must outlive it.
+   */
+  WalkableGrid(SDL_Point mapSize, const std::vector<char> &blockedTiles,
+               const ComponentGrid *connectedComponents = NULL)
+      : size(mapSize), blocked(&blockedTiles),
+        components(connectedComponents) {}
+
+  /**
+   * `GetSize`
+   *
+   *   Gets the width and height of the map in tiles.
+   */
+  SDL_Point GetSize() const { return size; }
+
+  /**
+   * `IsWalkable`
+   *
+   *   True if the point is inside the map and not blocked; otherwise, false.
+   */
+  bool IsWalkable(SDL_Point p) const {
+    return p.x >= 0 && p.y >= 0 && p.x < size.x && p.y < size.y &&
+           !(*blocked)[p.y * size.x + p.x];
+  }
+
+  /**
+   * `IsConnected`
+   *
+   *   False if the points are walkable and known to be in different
+   *   components; otherwise, true. Points on blocked tiles, such as a robot
+   *   caught by a new wall, are left for the search to decide.
+   */
+  bool IsConnected(SDL_Point a, SDL_Point b) const {
+    return components == NULL || !IsWalkable(a) || !IsWalkable(b) ||
+           components->IsConnected(a, b);
+  }
+};
+
+/**
+ * `FourWayNeighborhood`
  *
- *   Uses a modified A* algorithm to calculate the shortest path between two
- *   points.
+ *   Steps to the four side neighbors.
+ */
+struct FourWayNeighborhood {
+  static const int Count = 4;
+  static const int Offsets[Count][2];
+  static const unsigned int MaxCost = PATH_STRAIGHT_COST;
+  static unsigned int Cost(int, int) { return PATH_STRAIGHT_COST; }
+  static unsigned int MinSteps(unsigned int dx, unsigned int dy) {
+    return dx + dy;
+  }
+};
+
+/**
+ * `EightWayNeighborhood`
+ *
+ *   Steps to the four side and the four diagonal neighbors.
+ */
+struct EightWayNeighborhood {
+  static const int Count = 8;
+  static const int Offsets[Count][2];
+  static const unsigned int MaxCost = PATH_DIAGONAL_COST;
+  static unsigned int Cost(int dx, int dy) {
+    return dx != 0 && dy != 0 ? PATH_DIAGONAL_COST : PATH_STRAIGHT_COST;
+  }
+  static unsigned int MinSteps(unsigned int dx, unsigned int dy) {
+    return dx < dy ? dy : dx;
+  }
+};
+
+/**
+ * `ManhattanHeuristic`
+ *
+ *   The exact cost without obstacles in a four-way neighborhood. It
+ *   overestimates with diagonal steps.
+ */
+struct ManhattanHeuristic {
+  static unsigned int Estimate(unsigned int dx, unsigned int dy) {
+    return PATH_STRAIGHT_COST * (dx + dy);
+  }
+};
+
+/**
+ * `OctileHeuristic`
+ *
+ *   The exact cost without obstacles in an eight-way neighborhood.
+ */
+struct OctileHeuristic {
+  static unsigned int Estimate(unsigned int dx, unsigned int dy) {
+    unsigned int lo = dx < dy ? dx : dy;
+    unsigned int hi = dx < dy ? dy : dx;
+    return PATH_STRAIGHT_COST * (hi - lo) + PATH_DIAGONAL_COST * lo;
+  }
+};
+
+/**
+ * `ChebyshevHeuristic`
+ *
+ *   The number of steps without obstacles in an eight-way neighborhood, as if
+ *   diagonal steps cost the same as straight ones.
+ */
+struct ChebyshevHeuristic {
+  static unsigned int Estimate(unsigned int dx, unsigned int dy) {
+    return PATH_STRAIGHT_COST * (dx < dy ? dy : dx);
+  }
+};
+
+/**
+ * `BasicSearchPathAlgorithm`
+ *
+ *   Uses the A* algorithm to calculate the shortest path between two points.
  *
  * @description
- *   The algorithm makes a couple of assumptions; namely, that the cost from
- *   traversing between neighboring points is the same for all points, and that
- *   the target point is reachable from anywhere on the map.
+ *   The neighborhood policy gives the steps and their fixed-point costs, and
+ *   the heuristic policy estimates the remaining cost to the goal. Both are
+ *   resolved at compile time. With an admissible heuristic, such as octile or
+ *   Chebyshev for eight-way steps, the path found is a shortest one and every
+ *   point is expanded at most once. Each iteration expands one point and
+ *   visits all of its neighbors. A goal that the walkable grid knows to be in
+ *   another component than the start is unreachable without any iteration.
  *
- *   The heuristic cost from each point to the target point is simply the
- *   distance between the two points (without calculating the square root).
+ *   Improved points are pushed onto the open queue again instead of being
+ *   updated in place; stale entries are skipped when they reach the top. Ties
+ *   between equal f-scores go to the entry closest to the goal.
  *
  *   The result of the algorithm is a stack of points representing the path from
- *   and including the start point to the goal point.
+ *   and including the start point to the goal point, or empty if the goal is
+ *   unreachable.
+ *
+ *   The common instantiations are compiled once in `SearchPathAlgorithm.cpp`.
  */
-class SearchPathAlgorithm
+template <class Neighborhood, class Heuristic>
+class BasicSearchPathAlgorithm
     : public IterativeAlgorithm<std::vector<SDL_Point>, SDL_Point, SDL_Point> {
   struct SDL_PointHash {
-    std::size_t operator()(const SDL_Point value) const;
-  };
-  struct SDL_PointCompare {
-    SDL_PointCompare(const SearchPathAlgorithm &ownerAlgorithm)
-        : owner(ownerAlgorithm) {}
-    bool operator()(const SDL_Point lhs, const SDL_Point rhs) const;
-    const SearchPathAlgorithm &owner;
+    std::size_t operator()(const SDL_Point value) const {
+      std::size_t result = static_cast<std::size_t>(value.x);
+      result *= 2654435761U;
+      return result ^ static_cast<std::size_t>(value.y);
+    }
   };
   struct SDL_PointEqual {
-    bool operator()(const SDL_Point lhs, const SDL_Point rhs) const;
+    bool operator()(const SDL_Point lhs, const SDL_Point rhs) const {
+      return lhs.x == rhs.x && lhs.y == rhs.y;
+    }
+  };
+
+  /**
+   * `OpenEntry`
+   *
+   *   A point on the open queue with its scores when it was pushed.
+   */
+  struct OpenEntry {
+    SDL_Point point;
+    unsigned int fScore;
+    unsigned int gScore;
+  };
+  struct OpenEntryCompare {
+    bool operator()(const OpenEntry &lhs, const OpenEntry &rhs) const {
+      return lhs.fScore != rhs.fScore ? lhs.fScore > rhs.fScore
+                                      : lhs.gScore < rhs.gScore;
+    }
   };
   struct PriorityQueue
-      : public std::priority_queue<SDL_Point, std::vector<SDL_Point>,
-                                   SearchPathAlgorithm::SDL_PointCompare> {
-    PriorityQueue(const SearchPathAlgorithm &owner)
-        : std::priority_queue<SDL_Point, std::vector<SDL_Point>,
-                              SearchPathAlgorithm::SDL_PointCompare>(
-              SDL_PointCompare(owner)) {}
+      : public std::priority_queue<OpenEntry, std::vector<OpenEntry>,
+                                   OpenEntryCompare> {
     void clear() { this->c.clear(); }
+    std::vector<OpenEntry> &container() { return this->c; }
+    const std::vector<OpenEntry> &container() const { return this->c; }
   };
   using PointVector = std::vector<SDL_Point>;
-  using PointSet =
-      std::unordered_set<SDL_Point, SearchPathAlgorithm::SDL_PointHash,
-                         SearchPathAlgorithm::SDL_PointEqual>;
+  using PointSet = std::unordered_set<SDL_Point, SDL_PointHash, SDL_PointEqual>;
   template <class V>
   using PointMap =
-      std::unordered_map<SDL_Point, V, SearchPathAlgorithm::SDL_PointHash,
-                         SearchPathAlgorithm::SDL_PointEqual>;
+      std::unordered_map<SDL_Point, V, SDL_PointHash, SDL_PointEqual>;
 
   /**
-   * `loops`
+   * `Step`
    *
-   *   The array of loop headers.
+   *   The loop headers of the algorithm.
    */
-  std::function<bool()> loops[4];
+  enum class Step { Done, Expand, Reconstruct };
 
   /**
-   * `nextFn`
+   * `step`
    *
-   *   The next function to be called.
+   *   The loop header to be executed at the next iteration.
    */
-  std::function<bool()> *nextFn;
+  Step step;
 
   /**
-   * `getNeighbors`
+   * `grid`
    *
-   *   Gets the neighboring nodes from a given point.
+   *   The walkable tiles of the map.
    */
-  std::function<std::vector<SDL_Point>(SDL_Point)> getNeighbors;
+  WalkableGrid grid;
 
-  int i;
   SDL_Point argStart;
   SDL_Point argGoal;
   PriorityQueue openQueue;
-  PointSet openSet;
   PointSet closedSet;
   PointMap<SDL_Point> cameFrom;
   PointMap<unsigned int> gScore;
-  PointMap<unsigned int> fScore;
   SDL_Point current;
-  PointVector neighbors;
   PointVector result;
 
 public:
   /**
-   * `SearchPathAlgorithm`
+   * `BasicSearchPathAlgorithm`
    *
    *   Constructor.
    *
    * @param resultCallback
    *   Callback for the result of the algorithm.
    *
-   * @param getNeighborsFn
-   *   Function that returns the collection of neighboring points from a given
-   *   point.
+   * @param walkableGrid
+   *   The walkable tiles of the map.
    */
-  SearchPathAlgorithm(
+  BasicSearchPathAlgorithm(
       std::function<void(std::vector<SDL_Point> &)> resultCallback,
-      std::function<std::vector<SDL_Point>(SDL_Point)> getNeighborsFn);
+      const WalkableGrid &walkableGrid);
 
   /**
    * `Begin`
@@ -134,15 +308,106 @@ public:
    * @returns
    *   True if there is a next iteration; otherwise, false.
    */
-  bool Next() { return (*nextFn)(); }
+  bool Next() {
+    ProfileScope scope(ProfileZone::PathSearch);
+    switch (step) {
+    case Step::Expand:
+      return Expand();
+    case Step::Reconstruct:
+      return Reconstruct();
+    default:
+      return false;
+    }
+  }
+
+  /**
+   * `Cancel`
+   *
+   *   Abandons the search in progress without returning a result.
+   */
+  void Cancel() { step = Step::Done; }
+
+  /**
+   * `Save`
+   *
+   *   Writes the state of the search to a snapshot.
+   */
+  void Save(Snapshot &snapshot) const;
 
   /**
-   * `CalcFScore`
+   * `Restore`
    *
-   *   Calculates the f-score for the given point.
+   *   Reads the state of the search from a snapshot so that it resumes exactly
+   *   where it was saved.
    */
-  int CalcFScore(const SDL_Point p) const;
+  void Restore(Snapshot &snapshot);
+
+  /**
+   * `GetOpenSetSize`
+   *
+   *   Gets the number of entries in the open queue.
+   */
+  std::size_t GetOpenSetSize() const { return openQueue.size(); }
+
+  /**
+   * `GetPartialPath`
+   *
+   *   Gets the path from the start to the most promising point on the open
+   *   queue, as a stack like the result, or empty if no search is expanding.
+   */
+  void GetPartialPath(std::vector<SDL_Point> &path) const;
+
+  /**
+   * `CalcHScore`
+   *
+   *   Estimates the cost between the given points.
+   */
+  static unsigned int CalcHScore(const SDL_Point p, const SDL_Point target) {
+    int dx = p.x - target.x;
+    int dy = p.y - target.y;
+    return Heuristic::Estimate(static_cast<unsigned int>(dx < 0 ? -dx : dx),
+                               static_cast<unsigned int>(dy < 0 ? -dy : dy));
+  }
+
+  /**
+   * `CalcMinSteps`
+   *
+   *   Gets the fewest steps across the given distances without obstacles.
+   */
+  static unsigned int CalcMinSteps(unsigned int dx, unsigned int dy) {
+    return Neighborhood::MinSteps(dx, dy);
+  }
+
+  /**
+   * `GetMinSteps`
+   *
+   *   Gets a lower bound on the steps of the path the search in progress will
+   *   return, or 0 if it is not expanding.
+   *
+   * @description
+   *   The bound follows from the lowest f-score on the open queue, so it
+   *   rises as the search goes on. It holds as long as the heuristic never
+   *   overestimates.
+   */
+  unsigned int GetMinSteps() const;
 
 private:
-  int CalcDist(const SDL_Point a, const SDL_Point b) const;
+  bool Finish();
+  bool Expand();
+  bool Reconstruct();
 };
+
+extern template class BasicSearchPathAlgorithm<FourWayNeighborhood,
+                                               ManhattanHeuristic>;
+extern template class BasicSearchPathAlgorithm<EightWayNeighborhood,
+                                               OctileHeuristic>;
+extern template class BasicSearchPathAlgorithm<EightWayNeighborhood,
+                                               ChebyshevHeuristic>;
+
+/**
+ * `SearchPathAlgorithm`
+ *
+ *   The path search used by the factory and its robots.
+ */
+using SearchPathAlgorithm =
+    BasicSearchPathAlgorithm<EightWayNeighborhood, OctileHeuristic>;
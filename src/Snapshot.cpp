@@ -0,0 +1,85 @@
+/*******************************************************************************
+@file `Snapshot.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "Snapshot.h"
+#include "Machine.h"
+
+/**
+ * `SNAPSHOT_MAGIC`
+ *
+ *   The first four bytes of a snapshot file.
+ */
+#define SNAPSHOT_MAGIC "FSS7"
+
+void Snapshot::WriteMachine(const Machine *machine) {
+  Write(static_cast<Sint32>(machine == NULL ? -1 : machine->GetId()));
+}
+
+std::size_t Snapshot::ReadCount(std::size_t elementSize) {
+  Uint64 count = 0;
+  Read(count);
+  if (elementSize > 0 && count > (data.size() - position) / elementSize) {
+    isValid = false;
+    return 0;
+  }
+  return static_cast<std::size_t>(count);
+}
+
+Machine *Snapshot::ReadMachine() {
+  Sint32 id = -1;
+  Read(id);
+  if (id < 0)
+    return NULL;
+  if (machines == NULL || static_cast<std::size_t>(id) >= machines->size()) {
+    isValid = false;
+    return NULL;
+  }
+  return (*machines)[id];
+}
+
+bool Snapshot::Save(const char *path) const {
+  SDL_RWops *file = SDL_RWFromFile(path, "wb");
+  if (file == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to open snapshot '%s': %s\n",
+                 path, SDL_GetError());
+    return false;
+  }
+  bool ok =
+      SDL_RWwrite(file, SNAPSHOT_MAGIC, 4, 1) == 1 &&
+      (data.empty() || SDL_RWwrite(file, data.data(), data.size(), 1) == 1);
+  SDL_RWclose(file);
+  if (!ok)
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to write snapshot '%s'\n",
+                 path);
+  return ok;
+}
+
+bool Snapshot::Load(const char *path) {
+  SDL_RWops *file = SDL_RWFromFile(path, "rb");
+  if (file == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to open snapshot '%s': %s\n",
+                 path, SDL_GetError());
+    return false;
+  }
+  Sint64 size = SDL_RWsize(file);
+  char magic[4];
+  bool ok = size >= 4 && SDL_RWread(file, magic, 4, 1) == 1 &&
+            std::memcmp(magic, SNAPSHOT_MAGIC, 4) == 0;
+  Clear();
+  if (ok) {
+    data.resize(static_cast<std::size_t>(size - 4));
+    ok = data.empty() || SDL_RWread(file, data.data(), data.size(), 1) == 1;
+  }
+  SDL_RWclose(file);
+  if (!ok) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to read snapshot '%s'\n",
+                 path);
+    Clear();
+  }
+  return ok;
+}
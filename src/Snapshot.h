@@ -0,0 +1,226 @@
+/*******************************************************************************
+@file `Snapshot.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class Machine;
+
+/**
+ * `Snapshot`
+ *
+ *   A byte buffer holding the simulation state of a factory.
+ *
+ * @description
+ *   Values are copied in and out of the buffer as raw bytes, and vectors of
+ *   plain values are copied in a single block, so taking a snapshot costs
+ *   little more than copying the state. Clearing the snapshot keeps its
+ *   storage, so checkpointing repeatedly into the same snapshot does not
+ *   allocate once the buffer has grown to size.
+ *
+ *   Machines are written as their ids. Before reading, the factory supplies
+ *   the machine table that maps ids back to machines; see `SetMachines`.
+ *
+ *   Reading past the end of the buffer invalidates the snapshot instead of
+ *   failing each read, so restoring code reads straight through and checks
+ *   `IsValid` once at the end.
+ */
+class Snapshot {
+
+  /**
+   * `data`
+   *
+   *   The serialized state.
+   */
+  std::vector<char> data;
+
+  /**
+   * `position`
+   *
+   *   The read position in the buffer.
+   */
+  std::size_t position;
+
+  /**
+   * `isValid`
+   *
+   *   False if a read went past the end of the buffer; otherwise, true.
+   */
+  bool isValid;
+
+  /**
+   * `machines`
+   *
+   *   The machines of the factory, indexed by id.
+   */
+  const std::vector<Machine *> *machines;
+
+public:
+  Snapshot() : position(0), isValid(true), machines(NULL) {}
+
+  /**
+   * `Clear`
+   *
+   *   Empties the snapshot for writing without releasing its storage.
+   */
+  void Clear() {
+    data.clear();
+    Rewind();
+  }
+
+  /**
+   * `Swap`
+   *
+   *   Exchanges the contents and storage of two snapshots, each rewound.
+   */
+  void Swap(Snapshot &other) {
+    data.swap(other.data);
+    std::swap(machines, other.machines);
+    Rewind();
+    other.Rewind();
+  }
+
+  /**
+   * `Rewind`
+   *
+   *   Moves the read position back to the start of the snapshot.
+   */
+  void Rewind() {
+    position = 0;
+    isValid = true;
+  }
+
+  /**
+   * `IsValid`
+   *
+   *   False if a read went past the end of the snapshot; otherwise, true.
+   */
+  bool IsValid() const { return isValid; }
+
+  /**
+   * `GetSize`
+   *
+   *   Gets the size of the snapshot in bytes.
+   */
+  std::size_t GetSize() const { return data.size(); }
+
+  /**
+   * `SetMachines`
+   *
+   *   Sets the table used to map machine ids back to machines when reading.
+   */
+  void SetMachines(const std::vector<Machine *> *value) { machines = value; }
+
+  /**
+   * `Write`
+   *
+   *   Appends a plain value to the snapshot.
+   */
+  template <class T> void Write(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be written to a snapshot.");
+    WriteBytes(&value, sizeof(T));
+  }
+
+  /**
+   * `WriteVector`
+   *
+   *   Appends the size and the elements of a vector of plain values.
+   */
+  template <class T> void WriteVector(const std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be written to a snapshot.");
+    Write(static_cast<Uint64>(values.size()));
+    WriteBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  /**
+   * `WriteMachine`
+   *
+   *   Appends the id of a machine, or -1 for no machine.
+   */
+  void WriteMachine(const Machine *machine);
+
+  /**
+   * `Read`
+   *
+   *   Reads a plain value from the snapshot.
+   */
+  template <class T> void Read(T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be read from a snapshot.");
+    ReadBytes(&value, sizeof(T));
+  }
+
+  /**
+   * `ReadVector`
+   *
+   *   Reads a vector of plain values written by `WriteVector`.
+   */
+  template <class T> void ReadVector(std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be read from a snapshot.");
+    std::size_t count = ReadCount(sizeof(T));
+    values.resize(count);
+    ReadBytes(values.data(), count * sizeof(T));
+  }
+
+  /**
+   * `ReadCount`
+   *
+   *   Reads an element count, invalidating the snapshot if fewer than that
+   *   many elements of the given size remain.
+   */
+  std::size_t ReadCount(std::size_t elementSize);
+
+  /**
+   * `ReadMachine`
+   *
+   *   Reads a machine id and gets the machine it refers to, or NULL.
+   */
+  Machine *ReadMachine();
+
+  /**
+   * `Save`
+   *
+   *   Writes the snapshot to a file.
+   */
+  bool Save(const char *path) const;
+
+  /**
+   * `Load`
+   *
+   *   Reads a snapshot written by `Save` from a file.
+   */
+  bool Load(const char *path);
+
+private:
+  void WriteBytes(const void *bytes, std::size_t size) {
+    std::size_t end = data.size();
+    data.resize(end + size);
+    if (size > 0)
+      std::memcpy(&data[end], bytes, size);
+  }
+
+  void ReadBytes(void *bytes, std::size_t size) {
+    if (!isValid || size > data.size() - position) {
+      isValid = false;
+      std::memset(bytes, 0, size);
+      return;
+    }
+    if (size > 0)
+      std::memcpy(bytes, &data[position], size);
+    position += size;
+  }
+};
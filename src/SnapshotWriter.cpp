@@ -0,0 +1,52 @@
+/*******************************************************************************
+@file `SnapshotWriter.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "SnapshotWriter.h"
+
+bool SnapshotWriter::Write(Snapshot &value, const char *argPath) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isPending)
+      return false;
+    snapshot.Swap(value);
+    path = argPath;
+    isPending = true;
+  }
+  if (!thread.joinable()) {
+    isStopping = false;
+    thread = std::thread([this]() { this->Work(); });
+  }
+  pending.notify_one();
+  return true;
+}
+
+void SnapshotWriter::Close() {
+  if (!thread.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    isStopping = true;
+  }
+  pending.notify_one();
+  thread.join();
+}
+
+void SnapshotWriter::Work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    pending.wait(lock, [this]() { return isPending || isStopping; });
+    if (!isPending)
+      return;
+    // The buffer and path only change while nothing is pending, so the file
+    // is written without holding the lock.
+    lock.unlock();
+    snapshot.Save(path.c_str());
+    lock.lock();
+    isPending = false;
+  }
+}
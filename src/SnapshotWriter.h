@@ -0,0 +1,101 @@
+/*******************************************************************************
+@file `SnapshotWriter.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include "Snapshot.h"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * `SnapshotWriter`
+ *
+ *   Writes snapshots to files on a thread of its own.
+ *
+ * @description
+ *   `Write` swaps the given snapshot with the buffer of the writer and
+ *   returns at once, so the caller only pays for taking the snapshot, not for
+ *   the file. The caller gets back the buffer of the previous write, which
+ *   keeps its storage, so checkpointing repeatedly does not allocate once both
+ *   buffers have grown to size.
+ *
+ *   A snapshot handed over while the previous one is still being written is
+ *   dropped rather than waited for.
+ */
+class SnapshotWriter {
+
+  /**
+   * `thread`
+   *
+   *   The thread writing the files, started by the first `Write`.
+   */
+  std::thread thread;
+
+  std::mutex mutex;
+  std::condition_variable pending;
+
+  /**
+   * `snapshot`
+   *
+   *   The snapshot being written, or the last one written.
+   */
+  Snapshot snapshot;
+
+  /**
+   * `path`
+   *
+   *   The file the snapshot is written to.
+   */
+  std::string path;
+
+  /**
+   * `isPending`
+   *
+   *   True while the snapshot waits to be or is being written; otherwise,
+   *   false.
+   */
+  bool isPending;
+
+  /**
+   * `isStopping`
+   *
+   *   True if the thread should exit once the pending snapshot is written.
+   */
+  bool isStopping;
+
+public:
+  SnapshotWriter() : isPending(false), isStopping(false) {}
+  ~SnapshotWriter() { Close(); }
+
+  /**
+   * `Write`
+   *
+   *   Hands the snapshot over to be written to the given file.
+   *
+   * @param value
+   *   The snapshot to be written. It is swapped with the buffer of the
+   *   previous write, which the caller may clear and reuse.
+   *
+   * @returns
+   *   True if the snapshot was handed over; false if the previous one is
+   *   still being written, in which case the snapshot is left as is.
+   */
+  bool Write(Snapshot &value, const char *path);
+
+  /**
+   * `Close`
+   *
+   *   Waits for the pending snapshot to be written and stops the thread.
+   */
+  void Close();
+
+private:
+  void Work();
+};
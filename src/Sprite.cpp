@@ -50,3 +50,7 @@ void Sprite::SetDrawRegionSize(const int height, const int width) {
 void Sprite::Draw(SDL_Renderer *const sdlRenderer) {
   SDL_RenderCopy(sdlRenderer, _spritesheet, &_spriteRegion, &_drawRegion);
 }
+
+void Sprite::Capture(RenderState &state) {
+  state.AddSprite(_spritesheet, _spriteRegion, _drawRegion);
+}
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "RenderState.h"
 #include <SDL2/SDL.h>
 
 /**
@@ -118,4 +119,11 @@ public:
    *   Draws the sprite on the given renderer.
    */
   void Draw(SDL_Renderer *const sdlRenderer);
+
+  /**
+   * `Capture`
+   *
+   *   Adds the sprite to the given render state.
+   */
+  void Capture(RenderState &state);
 };
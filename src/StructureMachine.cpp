@@ -31,9 +31,41 @@ StructureMachine::StructureMachine(SDL_Texture *const spritesheet,
   IsIdleChanged();
 }
 
-void StructureMachine::Draw(SDL_Renderer *sdlRenderer) {
-  GetMachineSprite().Draw(sdlRenderer);
-  _progressSprite.Draw(sdlRenderer);
+void StructureMachine::Draw(SDL_Renderer *sdlRenderer, unsigned int tick) {
+  if (!IsIdle())
+    _progressSprite.SetFrame(8 * GetProgress(tick) / 100);
+  GetMachineSprite().Draw(sdlRenderer, tick);
+  _progressSprite.Draw(sdlRenderer, tick);
+}
+
+void StructureMachine::Capture(RenderState &state, unsigned int tick) {
+  if (!IsIdle())
+    _progressSprite.SetFrame(8 * GetProgress(tick) / 100);
+  GetMachineSprite().Capture(state, tick);
+  _progressSprite.Capture(state, tick);
+}
+
+Uint64 StructureMachine::GetDrawKey(unsigned int tick) {
+  Uint32 progressKey = IsIdle() ? _progressSprite.GetFrameKey(tick)
+                                : 8 * GetProgress(tick) / 100;
+  return Machine::GetDrawKey(tick) << 32 | progressKey;
+}
+
+void StructureMachine::Save(Snapshot &snapshot) const {
+  Machine::Save(snapshot);
+  snapshot.Write(_progressSprite.GetStartTick());
+}
+
+void StructureMachine::Restore(Snapshot &snapshot) {
+  Machine::Restore(snapshot);
+  // The frames are set up as when the machine last changed, then the
+  // animations resume from the saved start ticks rather than from now.
+  unsigned int startTick = GetMachineSprite().GetStartTick();
+  unsigned int progressStartTick;
+  snapshot.Read(progressStartTick);
+  IsIdleChanged();
+  GetMachineSprite().SetStartTick(startTick);
+  _progressSprite.SetStartTick(progressStartTick);
 }
 
 void StructureMachine::SetDrawPoint(const int x, const int y) {
@@ -43,14 +75,11 @@ void StructureMachine::SetDrawPoint(const int x, const int y) {
   SetRegionPoint(_idleSpriteRegion, x, y);
 }
 
-void StructureMachine::OnUpdate(unsigned int dt) {
-  if (IsIdle())
-    _progressSprite.Update(dt);
-  else
-    _progressSprite.SetFrame(8 * GetProgress() / 100);
-}
-
 void StructureMachine::IsIdleChanged() {
+  // Each station animates from when it last changed, not in step with the
+  // others.
+  GetMachineSprite().SetStartTick(GetUpdateTick());
+  _progressSprite.SetStartTick(GetUpdateTick());
   if (IsIdle()) {
     _progressSprite.SetFramesRegionPoint(48, 64);
     _progressSprite.SetFrameCount(2);
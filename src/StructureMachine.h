@@ -75,24 +75,47 @@ public:
   /**
    * `Draw`
    *
-   *   Draws the machine on the given renderer.
+   *   Draws the machine on the given renderer as it is at the given factory
+   *   tick.
    */
-  void Draw(SDL_Renderer *sdlRenderer);
+  void Draw(SDL_Renderer *sdlRenderer, unsigned int tick);
 
   /**
-   * `SetDrawPoint`
+   * `Capture`
    *
-   *   Sets the draw coordinates of the machine on the renderer.
+   *   Adds the machine and its progress bar to the given render state as they
+   *   are drawn at the given factory tick.
    */
-  void SetDrawPoint(const int x, const int y);
+  void Capture(RenderState &state, unsigned int tick);
+
+  /**
+   * `GetDrawKey`
+   *
+   *   Gets a value that changes whenever the machine or its progress bar would
+   *   be drawn with different frames at the given factory tick.
+   */
+  Uint64 GetDrawKey(unsigned int tick);
+
+  /**
+   * `Save`
+   *
+   *   Writes the simulation state of the machine to a snapshot.
+   */
+  void Save(Snapshot &snapshot) const;
 
-protected:
   /**
-   * `OnUpdate`
+   * `Restore`
    *
-   *   Event when the machine is being updated.
+   *   Reads the simulation state of the machine from a snapshot.
    */
-  void OnUpdate(unsigned int dt);
+  void Restore(Snapshot &snapshot);
+
+  /**
+   * `SetDrawPoint`
+   *
+   *   Sets the draw coordinates of the machine on the renderer.
+   */
+  void SetDrawPoint(const int x, const int y);
 
 private:
   /**
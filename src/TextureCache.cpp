@@ -0,0 +1,223 @@
+/*******************************************************************************
+@file `TextureCache.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "TextureCache.h"
+#include <SDL2/SDL_image.h>
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+#include <vector>
+
+/**
+ * `CACHE_MMAP`
+ *
+ *   Defined where baked textures are memory-mapped; elsewhere they are read
+ *   into memory with `SDL_RWops`.
+ */
+#if defined(__unix__) || defined(__APPLE__)
+#define CACHE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * `CACHE_MAGIC`
+ *
+ *   The first four bytes of a baked texture file.
+ */
+#define CACHE_MAGIC "FTC1"
+
+/**
+ * `CACHE_BYTE_ORDER`
+ *
+ *   Reads back as itself only on a machine of the byte order that wrote it.
+ */
+#define CACHE_BYTE_ORDER 0x01020304
+
+/**
+ * `CACHE_FORMAT`
+ *
+ *   The pixel format of baked textures, which renderers accept without
+ *   conversion.
+ */
+#define CACHE_FORMAT SDL_PIXELFORMAT_ARGB8888
+
+/**
+ * `CACHE_HEADER_SIZE`
+ *
+ *   The size in bytes of the header of a baked texture file.
+ */
+#define CACHE_HEADER_SIZE 24
+
+/**
+ * `COLOR_KEY`
+ *
+ *   The color of transparent pixels in the source images.
+ */
+#define COLOR_KEY 0xFF00FF
+
+bool TextureCache::Bake(const char *imagePath, const char *cachePath) {
+  SDL_Surface *image = IMG_Load(imagePath);
+  if (image == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to load image '%s': %s\n",
+                 imagePath, IMG_GetError());
+    return false;
+  }
+  SDL_Surface *surface = SDL_ConvertSurfaceFormat(image, CACHE_FORMAT, 0);
+  SDL_FreeSurface(image);
+  if (surface == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to convert image '%s': %s\n",
+                 imagePath, SDL_GetError());
+    return false;
+  }
+
+  // Apply the color key once here instead of at every start. Without a baked
+  // texture, the image is decoded when loading instead.
+  if (SDL_LockSurface(surface) != 0) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to lock image '%s': %s\n",
+                 imagePath, SDL_GetError());
+    SDL_FreeSurface(surface);
+    return false;
+  }
+  for (int y = 0; y < surface->h; y++) {
+    Uint32 *row = reinterpret_cast<Uint32 *>(
+        static_cast<char *>(surface->pixels) + y * surface->pitch);
+    for (int x = 0; x < surface->w; x++) {
+      if ((row[x] & 0xFFFFFF) == COLOR_KEY)
+        row[x] = 0;
+    }
+  }
+
+  Uint32 header[5] = {CACHE_BYTE_ORDER, CACHE_FORMAT,
+                      static_cast<Uint32>(surface->w),
+                      static_cast<Uint32>(surface->h),
+                      static_cast<Uint32>(surface->pitch)};
+  SDL_RWops *file = SDL_RWFromFile(cachePath, "wb");
+  bool ok = file != NULL && SDL_RWwrite(file, CACHE_MAGIC, 4, 1) == 1 &&
+            SDL_RWwrite(file, header, sizeof(header), 1) == 1 &&
+            SDL_RWwrite(file, surface->pixels,
+                        static_cast<std::size_t>(surface->pitch) * surface->h,
+                        1) == 1;
+  if (file != NULL)
+    SDL_RWclose(file);
+  SDL_UnlockSurface(surface);
+  SDL_FreeSurface(surface);
+  if (!ok)
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to write texture '%s': %s\n",
+                 cachePath, SDL_GetError());
+  return ok;
+}
+
+/**
+ * `createTexture`
+ *
+ *   Creates a texture from the contents of a baked texture file, or returns
+ *   NULL if they are invalid.
+ */
+static SDL_Texture *createTexture(SDL_Renderer *sdlRenderer,
+                                  const char *cachePath, const char *p,
+                                  std::size_t size) {
+  Uint32 header[5];
+  std::memcpy(header, p + 4, sizeof(header));
+  Uint32 width = header[2];
+  Uint32 height = header[3];
+  Uint32 pitch = header[4];
+  if (std::memcmp(p, CACHE_MAGIC, 4) != 0 || header[0] != CACHE_BYTE_ORDER ||
+      header[1] != CACHE_FORMAT || pitch < width * 4 ||
+      size - CACHE_HEADER_SIZE < static_cast<std::size_t>(pitch) * height) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Invalid texture '%s'\n",
+                cachePath);
+    return NULL;
+  }
+  SDL_Texture *texture = SDL_CreateTexture(
+      sdlRenderer, CACHE_FORMAT, SDL_TEXTUREACCESS_STATIC, width, height);
+  if (texture == NULL ||
+      SDL_UpdateTexture(texture, NULL, p + CACHE_HEADER_SIZE, pitch) != 0) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Unable to create texture from '%s': %s\n", cachePath,
+                SDL_GetError());
+    if (texture != NULL)
+      SDL_DestroyTexture(texture);
+    return NULL;
+  }
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+  return texture;
+}
+
+/**
+ * `isStale`
+ *
+ *   True if the image was modified after the baked texture was written.
+ */
+static bool isStale(const struct stat &cacheStat, const char *imagePath) {
+  struct stat imageStat;
+  return stat(imagePath, &imageStat) == 0 &&
+         imageStat.st_mtime > cacheStat.st_mtime;
+}
+
+#ifdef CACHE_MMAP
+SDL_Texture *TextureCache::Load(SDL_Renderer *sdlRenderer,
+                                const char *cachePath, const char *imagePath) {
+  int fd = open(cachePath, O_RDONLY);
+  if (fd < 0) {
+    if (errno != ENOENT)
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Unable to open texture '%s': %s\n", cachePath,
+                  std::strerror(errno));
+    return NULL;
+  }
+  struct stat cacheStat;
+  if (fstat(fd, &cacheStat) != 0 || cacheStat.st_size < CACHE_HEADER_SIZE ||
+      isStale(cacheStat, imagePath)) {
+    close(fd);
+    return NULL;
+  }
+  std::size_t size = static_cast<std::size_t>(cacheStat.st_size);
+  void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return NULL;
+  SDL_Texture *texture = createTexture(
+      sdlRenderer, cachePath, static_cast<const char *>(data), size);
+  munmap(data, size);
+  return texture;
+}
+#else
+SDL_Texture *TextureCache::Load(SDL_Renderer *sdlRenderer,
+                                const char *cachePath, const char *imagePath) {
+  struct stat cacheStat;
+  if (stat(cachePath, &cacheStat) != 0) {
+    if (errno != ENOENT)
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Unable to open texture '%s': %s\n", cachePath,
+                  std::strerror(errno));
+    return NULL;
+  }
+  if (isStale(cacheStat, imagePath))
+    return NULL;
+  SDL_RWops *file = SDL_RWFromFile(cachePath, "rb");
+  if (file == NULL) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Unable to open texture '%s': %s\n", cachePath,
+                SDL_GetError());
+    return NULL;
+  }
+  // The size is taken from the open file, which may differ from the one
+  // checked above if the file was baked again meanwhile.
+  Sint64 fileSize = SDL_RWsize(file);
+  std::vector<char> data(fileSize > 0 ? static_cast<std::size_t>(fileSize)
+                                      : 0);
+  bool ok = data.size() >= CACHE_HEADER_SIZE &&
+            SDL_RWread(file, data.data(), data.size(), 1) == 1;
+  SDL_RWclose(file);
+  if (!ok)
+    return NULL;
+  return createTexture(sdlRenderer, cachePath, data.data(), data.size());
+}
+#endif
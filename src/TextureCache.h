@@ -0,0 +1,51 @@
+/*******************************************************************************
+@file `TextureCache.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/**
+ * `TextureCache`
+ *
+ *   Bakes images into raw pixel files that load without decoding.
+ *
+ * @description
+ *   A baked file holds the pixels of the image in the format textures are
+ *   created in, with the transparent color already turned into alpha. Loading
+ *   one maps the file into memory, or reads it in one go where `mmap` is not
+ *   available, and uploads it with a single `SDL_UpdateTexture`; nothing is
+ *   decoded or converted, and SDL_image is not needed.
+ *
+ *   The file holds a four byte magic, a byte order mark, and the pixel format,
+ *   width, height and pitch of the pixels that follow, each a 32-bit value.
+ *   Pixels are stored in the byte order of the machine that baked them; a file
+ *   baked on a machine of the other byte order is rejected.
+ */
+class TextureCache {
+public:
+  /**
+   * `Bake`
+   *
+   *   Converts an image to a baked texture file. SDL_image must be
+   *   initialized.
+   */
+  static bool Bake(const char *imagePath, const char *cachePath);
+
+  /**
+   * `Load`
+   *
+   *   Creates a texture from a baked texture file.
+   *
+   * @return
+   *   The texture, or NULL if the file is missing, invalid, or older than the
+   *   image it was baked from.
+   */
+  static SDL_Texture *Load(SDL_Renderer *sdlRenderer, const char *cachePath,
+                           const char *imagePath);
+};
@@ -0,0 +1,102 @@
+/*******************************************************************************
+@file `ThreadPool.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : slices(NULL), body(NULL), chunkSize(1), generation(0), busyCount(0),
+      isQuitting(false) {
+  if (threadCount == 0)
+    threadCount = std::thread::hardware_concurrency();
+  if (threadCount == 0)
+    threadCount = 1;
+  slices = new Slice[threadCount];
+  for (unsigned int i = 1; i < threadCount; i++)
+    threads.push_back(std::thread([this, i]() { this->Work(i); }));
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    isQuitting = true;
+  }
+  started.notify_all();
+  for (std::thread &t : threads)
+    t.join();
+  delete[] slices;
+}
+
+void ThreadPool::ParallelFor(
+    std::size_t count, std::size_t chunk,
+    const std::function<void(std::size_t, std::size_t)> &loopBody) {
+  if (chunk == 0)
+    chunk = 1;
+  if (threads.empty() || count <= chunk) {
+    if (count > 0)
+      loopBody(0, count);
+    return;
+  }
+
+  // Split the loop into one slice per thread.
+  unsigned int n = GetThreadCount();
+  for (unsigned int i = 0; i < n; i++) {
+    slices[i].next.store(count * i / n, std::memory_order_relaxed);
+    slices[i].end = count * (i + 1) / n;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    body = &loopBody;
+    chunkSize = chunk;
+    busyCount = threads.size();
+    generation++;
+  }
+  started.notify_all();
+
+  Run(0);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this]() { return busyCount == 0; });
+  body = NULL;
+}
+
+void ThreadPool::Work(unsigned int index) {
+  unsigned int seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      started.wait(lock,
+                   [this, seen]() { return isQuitting || generation != seen; });
+      if (isQuitting)
+        return;
+      seen = generation;
+    }
+    Run(index);
+    Profiler::FlushThread();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      busyCount--;
+    }
+    finished.notify_one();
+  }
+}
+
+void ThreadPool::Run(unsigned int index) {
+  unsigned int n = GetThreadCount();
+  // Start with the own slice, then steal from the others in turn.
+  for (unsigned int k = 0; k < n; k++) {
+    Slice &slice = slices[(index + k) % n];
+    for (;;) {
+      std::size_t begin = slice.next.fetch_add(chunkSize);
+      if (begin >= slice.end)
+        break;
+      std::size_t end = begin + chunkSize;
+      (*body)(begin, end < slice.end ? end : slice.end);
+    }
+  }
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+@file `ThreadPool.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * `ThreadPool`
+ *
+ *   A fixed set of worker threads for running loops in parallel.
+ *
+ * @description
+ *   `ParallelFor` gives each thread, including the calling thread, an equal
+ *   slice of the loop. Each thread takes chunks from the front of its own slice
+ *   and, once that is exhausted, steals chunks from the slices of the others,
+ *   so a thread that drew expensive iterations does not hold up the rest.
+ *
+ *   Slices are claimed with a single atomic increment per chunk, and workers
+ *   sleep between loops, so an idle pool costs nothing.
+ */
+class ThreadPool {
+
+  /**
+   * `Slice`
+   *
+   *   The iterations of the current loop owned by one thread. Padded to a
+   *   cache line so that threads claiming from their own slices do not contend.
+   */
+  struct Slice {
+    std::atomic<std::size_t> next;
+    std::size_t end;
+    char padding[64 - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+  };
+
+  /**
+   * `threads`
+   *
+   *   The worker threads. The calling thread is participant 0.
+   */
+  std::vector<std::thread> threads;
+
+  /**
+   * `slices`
+   *
+   *   One slice per participant.
+   */
+  Slice *slices;
+
+  /**
+   * `body`
+   *
+   *   The body of the current loop.
+   */
+  const std::function<void(std::size_t, std::size_t)> *body;
+
+  /**
+   * `chunkSize`
+   *
+   *   The number of iterations claimed at a time in the current loop.
+   */
+  std::size_t chunkSize;
+
+  std::mutex mutex;
+  std::condition_variable started;
+  std::condition_variable finished;
+  unsigned int generation;
+  unsigned int busyCount;
+  bool isQuitting;
+
+public:
+  /**
+   * `ThreadPool`
+   *
+   *   Constructor.
+   *
+   * @param threadCount
+   *   The number of threads running each loop, including the calling thread,
+   *   or 0 for one per core.
+   */
+  ThreadPool(unsigned int threadCount);
+
+  /**
+   * `~ThreadPool`
+   *
+   *   Destructor. Waits for the workers to exit.
+   */
+  ~ThreadPool();
+
+  /**
+   * `GetThreadCount`
+   *
+   *   Gets the number of threads running each loop.
+   */
+  unsigned int GetThreadCount() const { return threads.size() + 1; }
+
+  /**
+   * `ParallelFor`
+   *
+   *   Calls `loopBody(begin, end)` over disjoint ranges covering `[0, count)`
+   *   and returns when all of them are done.
+   *
+   * @description
+   *   Loops of no more than one chunk run on the calling thread alone.
+   */
+  void
+  ParallelFor(std::size_t count, std::size_t chunk,
+              const std::function<void(std::size_t, std::size_t)> &loopBody);
+
+private:
+  void Work(unsigned int index);
+  void Run(unsigned int index);
+};
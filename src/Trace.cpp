@@ -0,0 +1,105 @@
+/*******************************************************************************
+@file `Trace.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "Trace.h"
+#include <cstdio>
+
+/**
+ * `TRACE_BUFFER_SIZE`
+ *
+ *   The size in bytes of the event buffer.
+ */
+#define TRACE_BUFFER_SIZE (1 << 20)
+
+/**
+ * `TRACE_EVENT_SIZE`
+ *
+ *   The maximum size in bytes of a single formatted event.
+ */
+#define TRACE_EVENT_SIZE 256
+
+static char buffer[TRACE_BUFFER_SIZE];
+static std::size_t bufferSize = 0;
+static Uint64 startCounter = 0;
+static const char *separator = "";
+
+SDL_RWops *Trace::file = NULL;
+
+static void flush(SDL_RWops *file) {
+  SDL_RWwrite(file, buffer, 1, bufferSize);
+  bufferSize = 0;
+}
+
+static double toMicroseconds(Uint64 counter) {
+  return 1000000.0 * static_cast<double>(counter - startCounter) /
+         static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+/**
+ * `append`
+ *
+ *   Formats an event into the buffer, flushing the buffer first if the event
+ *   might not fit.
+ */
+template <class... Args>
+static void append(SDL_RWops *file, const char *format, Args... args) {
+  if (bufferSize + TRACE_EVENT_SIZE > TRACE_BUFFER_SIZE)
+    flush(file);
+  int n = std::snprintf(buffer + bufferSize, TRACE_EVENT_SIZE, format, args...);
+  bufferSize += n < TRACE_EVENT_SIZE ? n : TRACE_EVENT_SIZE - 1;
+}
+
+bool Trace::Start(const char *path) {
+  if (file != NULL)
+    Stop();
+  file = SDL_RWFromFile(path, "wb");
+  if (file == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to open trace '%s': %s\n",
+                 path, SDL_GetError());
+    return false;
+  }
+  startCounter = SDL_GetPerformanceCounter();
+  separator = "";
+  append(file, "[\n");
+  return true;
+}
+
+void Trace::Stop() {
+  if (file == NULL)
+    return;
+  append(file, "\n]\n");
+  flush(file);
+  SDL_RWclose(file);
+  file = NULL;
+}
+
+void Trace::Complete(const char *name, Uint64 start, Uint64 end) {
+  double ts = toMicroseconds(start);
+  append(file,
+         "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+         "\"dur\":%.3f}",
+         separator, name, ts, toMicroseconds(end) - ts);
+  separator = ",\n";
+}
+
+void Trace::Instant(const char *name, const void *source, bool value) {
+  append(file,
+         "%s{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":1,"
+         "\"ts\":%.3f,\"args\":{\"source\":\"%p\",\"value\":%s}}",
+         separator, name, toMicroseconds(SDL_GetPerformanceCounter()), source,
+         value ? "true" : "false");
+  separator = ",\n";
+}
+
+void Trace::Counter(const char *name, long long value) {
+  append(file,
+         "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+         "\"args\":{\"value\":%lld}}",
+         separator, name, toMicroseconds(SDL_GetPerformanceCounter()), value);
+  separator = ",\n";
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+@file `Trace.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/**
+ * `Trace`
+ *
+ *   Records a timeline of the session in the Chrome trace event format, which
+ *   can be loaded into `chrome://tracing` or Perfetto.
+ *
+ * @description
+ *   Events are formatted into an in-memory buffer that is only written to the
+ *   trace file when it fills up or the trace is stopped, so recording does not
+ *   distort the timings being recorded. Timestamps are taken from the
+ *   high-resolution performance counter.
+ */
+class Trace {
+
+  /**
+   * `file`
+   *
+   *   The trace file being written; `NULL` if not tracing.
+   */
+  static SDL_RWops *file;
+
+public:
+  /**
+   * `IsEnabled`
+   *
+   *   True if a trace is being recorded; otherwise, false.
+   */
+  static bool IsEnabled() { return file != NULL; }
+
+  /**
+   * `Start`
+   *
+   *   Starts recording a trace to the given file.
+   *
+   * @returns
+   *   True if the trace file was opened; otherwise, false.
+   */
+  static bool Start(const char *path);
+
+  /**
+   * `Stop`
+   *
+   *   Flushes the remaining events and closes the trace file.
+   */
+  static void Stop();
+
+  /**
+   * `Complete`
+   *
+   *   Records a span between two performance counter values.
+   */
+  static void Complete(const char *name, Uint64 start, Uint64 end);
+
+  /**
+   * `Instant`
+   *
+   *   Records an instant event from the given source object.
+   */
+  static void Instant(const char *name, const void *source, bool value);
+
+  /**
+   * `Counter`
+   *
+   *   Records the value of a counter.
+   */
+  static void Counter(const char *name, long long value);
+};
+
+/**
+ * `TraceScope`
+ *
+ *   Records a span from its construction to its destruction.
+ */
+class TraceScope {
+  const char *name;
+  Uint64 start;
+
+public:
+  TraceScope(const char *spanName)
+      : name(spanName),
+        start(Trace::IsEnabled() ? SDL_GetPerformanceCounter() : 0) {}
+  ~TraceScope() {
+    if (start != 0 && Trace::IsEnabled())
+      Trace::Complete(name, start, SDL_GetPerformanceCounter());
+  }
+};
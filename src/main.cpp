@@ -7,14 +7,87 @@
 *******************************************************************************/
 
 #include "Factory.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "RenderBuffer.h"
+#include "ReplayLog.h"
+#include "ScenarioGenerator.h"
+#include "Snapshot.h"
+#include "SnapshotWriter.h"
+#include "TextureCache.h"
+#include "Trace.h"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 #define SCREEN_HEIGHT 480
 #define SCREEN_WIDTH 640
 
+/**
+ * `SPRITESHEET_IMAGE`
+ *
+ *   The image file of the factory spritesheet.
+ */
+#define SPRITESHEET_IMAGE "sheet.png"
+
+/**
+ * `SPRITESHEET_CACHE`
+ *
+ *   The baked texture file of the factory spritesheet.
+ */
+#define SPRITESHEET_CACHE "sheet.tex"
+
+/**
+ * `PROFILE_LOG_INTERVAL`
+ *
+ *   The number of ticks between profile summaries in the log.
+ */
+#define PROFILE_LOG_INTERVAL 5000
+
+/**
+ * `METRICS_INTERVAL`
+ *
+ *   The number of simulated ticks between records in the metrics file.
+ */
+#define METRICS_INTERVAL 10000
+
+/**
+ * `HEADLESS_STEP`
+ *
+ *   The number of ticks per update when running without a window.
+ */
+#define HEADLESS_STEP 16
+
+/**
+ * `CHECKPOINT_INTERVAL`
+ *
+ *   The number of simulated ticks between checkpoint snapshots.
+ */
+#define CHECKPOINT_INTERVAL 5000
+
+/**
+ * `MAX_FIXED_STEPS`
+ *
+ *   The most fixed steps taken in a single frame, so that a slow frame does not
+ *   fall further and further behind.
+ */
+#define MAX_FIXED_STEPS 8
+
+/**
+ * `MAX_IDLE_WAIT`
+ *
+ *   The most milliseconds the main loop blocks while the factory is idle, so
+ *   that the animations of idle stations keep being drawn.
+ */
+#define MAX_IDLE_WAIT 100u
+
 /* Static variables ***********************************************************/
 
 /**
@@ -45,27 +118,347 @@ static SDL_Texture *factorySpritesheet = NULL;
  */
 static Factory *factory = NULL;
 
+/**
+ * `showProfile`
+ *
+ *   True if the profiler overlay is drawn; otherwise, false.
+ */
+static bool showProfile = false;
+
+/**
+ * `metricsWriter`
+ *
+ *   Writes the factory metrics to a file, if requested.
+ */
+static MetricsWriter metricsWriter;
+
+/**
+ * `layoutPath`
+ *
+ *   The layout file of the factory.
+ */
+static const char *layoutPath = "factory.layout";
+
+/**
+ * `scenarioGenerator`
+ *
+ *   Generates the layout when no layout file is used.
+ */
+static ScenarioGenerator scenarioGenerator;
+
+/**
+ * `isGenerated`
+ *
+ *   True if the layout is generated instead of loaded; otherwise, false.
+ */
+static bool isGenerated = false;
+
+/**
+ * `fixedStep`
+ *
+ *   The number of ticks per factory update, or 0 to update by the elapsed
+ *   time of each frame.
+ */
+static unsigned int fixedStep = 0;
+
+/**
+ * `stepRemainder`
+ *
+ *   The elapsed ticks not yet consumed by a fixed step.
+ */
+static unsigned int stepRemainder = 0;
+
+/**
+ * `threadCount`
+ *
+ *   The number of threads that advance the robots, or 0 for one per core.
+ */
+static unsigned int threadCount = 1;
+
+/**
+ * `isDeferringEvents`
+ *
+ *   True if the factory handles machine events once per update; otherwise,
+ *   false.
+ */
+static bool isDeferringEvents = false;
+
+/**
+ * `isPipelinedPlanning`
+ *
+ *   True if robots plan their next leg while travelling; otherwise, false.
+ */
+static bool isPipelinedPlanning = false;
+
+/**
+ * `anytimeBudget`
+ *
+ *   The number of search iterations after which robots walk a provisional
+ *   path, or 0 if they wait for their target.
+ */
+static unsigned int anytimeBudget = 0;
+
+/**
+ * `replayLog`
+ *
+ *   Records or replays the ticks of each factory update.
+ */
+static ReplayLog replayLog;
+
+/**
+ * `snapshot`
+ *
+ *   The snapshot used for checkpoints and restoring.
+ */
+static Snapshot snapshot;
+
+/**
+ * `checkpointWriter`
+ *
+ *   Writes checkpoints to their file off the simulation thread.
+ */
+static SnapshotWriter checkpointWriter;
+
+/**
+ * `checkpointPath`
+ *
+ *   The file checkpoints are written to, or NULL.
+ */
+static const char *checkpointPath = NULL;
+
+/**
+ * `checkpointTicks`
+ *
+ *   The number of simulated ticks since the last checkpoint.
+ */
+static unsigned long long checkpointTicks = 0;
+
+/**
+ * `isPartialRedraw`
+ *
+ *   True if only the changed regions of the factory are redrawn each frame;
+ *   otherwise, false.
+ */
+static bool isPartialRedraw = false;
+
+/**
+ * `backbuffer`
+ *
+ *   The texture holding the last drawn factory for partial redraws, or NULL.
+ */
+static SDL_Texture *backbuffer = NULL;
+
+/**
+ * `dirtyRegions`
+ *
+ *   The regions of the backbuffer to be redrawn this frame.
+ */
+static std::vector<SDL_Rect> dirtyRegions;
+
+/**
+ * `isPresentNeeded`
+ *
+ *   True if the window must be presented even when nothing was redrawn.
+ */
+static bool isPresentNeeded = true;
+
+/**
+ * `framePacer`
+ *
+ *   Limits the main loop to the target frame rate.
+ */
+static FramePacer framePacer;
+
+/**
+ * `targetFps`
+ *
+ *   The target number of frames per second, or 0 for no limit.
+ */
+static unsigned int targetFps = 60;
+
+/**
+ * `isVsync`
+ *
+ *   True if presenting waits for the vertical retrace; otherwise, false.
+ */
+static bool isVsync = false;
+
+/**
+ * `isIdleWaiting`
+ *
+ *   True if the main loop blocks until the next event while the factory is
+ *   idle; otherwise, false.
+ */
+static bool isIdleWaiting = false;
+
+/**
+ * `isSimulationThreaded`
+ *
+ *   True if the factory is updated on its own thread and drawn from the
+ *   render states it publishes; otherwise, false.
+ */
+static bool isSimulationThreaded = false;
+
+/**
+ * `renderBuffer`
+ *
+ *   Passes render states from the simulation thread to the main thread.
+ */
+static RenderBuffer renderBuffer;
+
+/**
+ * `isSimulationStopping`
+ *
+ *   Set by the main thread when the simulation thread must finish.
+ */
+static std::atomic<bool> isSimulationStopping(false);
+
+/**
+ * `isImageInitialized`
+ *
+ *   True if SDL_image has been initialized; otherwise, false.
+ */
+static bool isImageInitialized = false;
+
+/**
+ * `candidateCount`
+ *
+ *   The number of nearest candidates robots pick their targets from, or 0 for
+ *   all of them.
+ */
+static unsigned int candidateCount = 8;
+
+/**
+ * `isBatchedAssignment`
+ *
+ *   True if targets are assigned to waiting robots jointly; otherwise, false.
+ */
+static bool isBatchedAssignment = false;
+
 /* Function declarations ******************************************************/
 
 static bool init();
 static void close();
 static void update(unsigned int);
+static void step(unsigned int);
 static void draw();
+static void drawPartial();
+static void drawState();
+static void simulate();
+static bool loadLayout(FactoryLayout &);
+static bool restoreFactory(const char *);
+static int runHeadless(unsigned long long, const char *);
+static bool initImage();
 static SDL_Texture *loadTexture(const char *const);
 
 /* Main ***********************************************************************/
 
-int main() {
+int main(int argc, char *argv[]) {
+
+  /*** Parse command line options. ***/
+  const char *bakePath = NULL;
+  bool isBakingTextures = false;
+  const char *restorePath = NULL;
+  unsigned long long headlessTicks = 0;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--profile") == 0)
+      Profiler::SetEnabled(true);
+    else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+      Trace::Start(argv[++i]);
+    else if (std::strcmp(argv[i], "--metrics") == 0 && i + 1 < argc)
+      metricsWriter.Open(argv[++i]);
+    else if (std::strcmp(argv[i], "--candidates") == 0 && i + 1 < argc)
+      candidateCount = std::strtoul(argv[++i], NULL, 10);
+    else if (std::strcmp(argv[i], "--batched") == 0)
+      isBatchedAssignment = true;
+    else if (std::strcmp(argv[i], "--layout") == 0 && i + 1 < argc)
+      layoutPath = argv[++i];
+    else if (std::strcmp(argv[i], "--bake-layout") == 0 && i + 1 < argc)
+      bakePath = argv[++i];
+    else if (std::strcmp(argv[i], "--bake-textures") == 0)
+      isBakingTextures = true;
+    else if (std::strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+      if (!scenarioGenerator.Parse(argv[++i]))
+        return -1;
+      isGenerated = true;
+    } else if (std::strcmp(argv[i], "--headless") == 0 && i + 1 < argc)
+      headlessTicks = std::strtoull(argv[++i], NULL, 10);
+    else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+      threadCount = std::strtoul(argv[++i], NULL, 10);
+    else if (std::strcmp(argv[i], "--deferred-events") == 0)
+      isDeferringEvents = true;
+    else if (std::strcmp(argv[i], "--pipeline") == 0)
+      isPipelinedPlanning = true;
+    else if (std::strcmp(argv[i], "--anytime") == 0 && i + 1 < argc)
+      anytimeBudget = std::strtoul(argv[++i], NULL, 10);
+    else if (std::strcmp(argv[i], "--fixed-step") == 0 && i + 1 < argc)
+      fixedStep = std::strtoul(argv[++i], NULL, 10);
+    else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+      if (!replayLog.Record(argv[++i]))
+        return -1;
+    } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      if (!replayLog.Replay(argv[++i]))
+        return -1;
+    } else if (std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc)
+      checkpointPath = argv[++i];
+    else if (std::strcmp(argv[i], "--restore") == 0 && i + 1 < argc)
+      restorePath = argv[++i];
+    else if (std::strcmp(argv[i], "--partial-redraw") == 0)
+      isPartialRedraw = true;
+    else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+      targetFps = std::strtoul(argv[++i], NULL, 10);
+    else if (std::strcmp(argv[i], "--vsync") == 0)
+      isVsync = true;
+    else if (std::strcmp(argv[i], "--idle-wait") == 0)
+      isIdleWaiting = true;
+    else if (std::strcmp(argv[i], "--sim-thread") == 0)
+      isSimulationThreaded = true;
+  }
+
+  /*** Partial redraws read the factory, which the render thread cannot. ***/
+  if (isSimulationThreaded && isPartialRedraw) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Partial redraws are not used with a simulation thread\n");
+    isPartialRedraw = false;
+  }
+
+  /*** Convert the layout to the binary format without running. ***/
+  if (bakePath != NULL) {
+    FactoryLayout layout;
+    return loadLayout(layout) && layout.SaveBinary(bakePath) ? 0 : -1;
+  }
+
+  /*** Convert the spritesheet to a baked texture without running. ***/
+  if (isBakingTextures) {
+    bool ok = initImage() &&
+              TextureCache::Bake(SPRITESHEET_IMAGE, SPRITESHEET_CACHE);
+    close();
+    return ok ? 0 : -1;
+  }
+
+  /*** Run the simulation without a window. ***/
+  if (headlessTicks > 0)
+    return runHeadless(headlessTicks, restorePath);
 
   /*** Initialize SDL and global data. ***/
-  if (!init())
+  if (!init() || !restoreFactory(restorePath)) {
+    close();
     return -1;
+  }
+
+  /*** Start the simulation thread. ***/
+  std::thread simulation;
+  if (isSimulationThreaded)
+    simulation = std::thread(simulate);
 
   /*** Start the render loop. ***/
+  framePacer.SetTargetRate(targetFps);
   SDL_Event evt;
   bool quit = false;
   unsigned int currTick = SDL_GetTicks();
   unsigned int prevTick = currTick;
+  unsigned int profileTick = currTick;
+  unsigned long long metricsTicks = 0;
   while (!quit) {
 
     /*** Handle SDL events. ***/
@@ -74,18 +467,68 @@ int main() {
       case SDL_QUIT:
         quit = true;
         break;
+      case SDL_KEYDOWN:
+        if (evt.key.keysym.sym == SDLK_F3) {
+          showProfile = !showProfile;
+          Profiler::SetEnabled(Profiler::IsEnabled() || showProfile);
+          isPresentNeeded = true;
+        }
+        break;
+      case SDL_WINDOWEVENT:
+        isPresentNeeded = true;
+        break;
+      case SDL_RENDER_TARGETS_RESET:
+        if (!isSimulationThreaded)
+          factory->InvalidateDraw();
+        break;
       }
     }
 
+    /*** Draw the newest state published by the simulation thread. ***/
+    if (isSimulationThreaded) {
+      drawState();
+      Profiler::FlushThread();
+      framePacer.Wait();
+      continue;
+    }
+
     /*** Update the window. ***/
     update(currTick - prevTick);
     draw();
+    Profiler::EndFrame();
+
+    /*** Write the metrics periodically. ***/
+    metricsTicks += currTick - prevTick;
+    if (metricsWriter.IsOpen() && metricsTicks >= METRICS_INTERVAL) {
+      metricsWriter.Write(factory->GetMetrics());
+      metricsTicks = 0;
+    }
+
+    /*** Log the profile periodically. ***/
+    if (Profiler::IsEnabled() &&
+        currTick - profileTick >= PROFILE_LOG_INTERVAL) {
+      Profiler::LogSummary();
+      profileTick = currTick;
+    }
+
+    /*** Wait for the next frame, or until the factory changes. ***/
+    unsigned int idleTicks = isIdleWaiting ? factory->GetIdleTicks() : 0;
+    if (idleTicks > framePacer.GetPeriodTicks())
+      framePacer.WaitIdle(std::min(idleTicks, MAX_IDLE_WAIT));
+    else
+      framePacer.Wait();
 
     /*** Update the previous and current tick. ***/
     prevTick = currTick;
     currTick = SDL_GetTicks();
   }
 
+  /*** Stop the simulation thread. ***/
+  if (simulation.joinable()) {
+    isSimulationStopping = true;
+    simulation.join();
+  }
+
   close();
 
   return 0;
@@ -107,15 +550,6 @@ static bool init() {
     return false;
   }
 
-  /*** Initialize PNG loading. ***/
-  const int imgFlags = IMG_INIT_PNG;
-  if (!(IMG_Init(imgFlags) & imgFlags)) {
-    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to initialize SDL_Image: %s\n",
-                 IMG_GetError());
-    close();
-    return false;
-  }
-
   /*** Create the main window. ***/
   sdlWindow = SDL_CreateWindow("Factory Example", SDL_WINDOWPOS_UNDEFINED,
                                SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH,
@@ -128,7 +562,12 @@ static bool init() {
   }
 
   /*** Create renderer for the window. ***/
-  sdlRenderer = SDL_CreateRenderer(sdlWindow, -1, SDL_RENDERER_ACCELERATED);
+  Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+  if (isPartialRedraw)
+    rendererFlags |= SDL_RENDERER_TARGETTEXTURE;
+  if (isVsync)
+    rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+  sdlRenderer = SDL_CreateRenderer(sdlWindow, -1, rendererFlags);
   if (sdlRenderer == NULL) {
     SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to create renderer: %s\n",
                  SDL_GetError());
@@ -136,39 +575,50 @@ static bool init() {
     return false;
   }
 
+  /*** Create the backbuffer for partial redraws. ***/
+  if (isPartialRedraw) {
+    backbuffer = SDL_CreateTexture(sdlRenderer, SDL_PIXELFORMAT_RGBA8888,
+                                   SDL_TEXTUREACCESS_TARGET, SCREEN_WIDTH,
+                                   SCREEN_HEIGHT);
+    if (backbuffer == NULL)
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Unable to create backbuffer, redrawing every frame: %s\n",
+                  SDL_GetError());
+  }
+
   /*** Set renderer color. ***/
   SDL_SetRenderDrawColor(sdlRenderer, 0, 0, 0, 1);
 
-  /*** Load image. ***/
-  factorySpritesheet = loadTexture("sheet.png");
+  /*** Load the spritesheet, from the baked texture if it is up to date. ***/
+  factorySpritesheet =
+      TextureCache::Load(sdlRenderer, SPRITESHEET_CACHE, SPRITESHEET_IMAGE);
+  if (factorySpritesheet == NULL)
+    factorySpritesheet = loadTexture(SPRITESHEET_IMAGE);
   if (factorySpritesheet == NULL) {
     close();
     return false;
   }
 
+  /*** Load the layout. ***/
+  FactoryLayout layout;
+  if (!loadLayout(layout)) {
+    close();
+    return false;
+  }
+
   /*** Create the factory. ***/
-  factory = new Factory(factorySpritesheet, 0, 0, 15, 11);
+  factory = new Factory(factorySpritesheet, 0, 0, layout.width, layout.height);
   factory->SetDrawPoint((SCREEN_WIDTH - factory->GetDrawWidth()) / 2,
                        (SCREEN_HEIGHT - factory->GetDrawHeight()) / 2);
+  factory->SetCandidateCount(candidateCount);
+  factory->SetBatchedAssignment(isBatchedAssignment);
 
-  /*** Add consumers. ***/
-  factory->AddConsumerMachine(1, 0);
-  factory->AddConsumerMachine(4, 0);
-  factory->AddConsumerMachine(7, 0);
-  factory->AddConsumerMachine(10, 0);
-  factory->AddConsumerMachine(13, 0);
-
-  /*** Add producers. ***/
-  factory->AddProducerMachine(1, 9);
-  factory->AddProducerMachine(4, 9);
-  factory->AddProducerMachine(7, 9);
-  factory->AddProducerMachine(10, 9);
-  factory->AddProducerMachine(13, 9);
-
-  /*** Add robots. ***/
-  factory->AddRobotMachine(7, 5);
-  factory->AddRobotMachine(7, 5);
-  factory->AddRobotMachine(7, 5);
+  /*** Add blocked tiles, stations and robots. ***/
+  factory->SetThreadCount(threadCount);
+  factory->SetDeferredEvents(isDeferringEvents);
+  factory->SetAnytimeBudget(anytimeBudget);
+  factory->SetPipelinedPlanning(isPipelinedPlanning);
+  factory->Load(layout);
 
   return true;
 }
@@ -182,6 +632,9 @@ static void close() {
 
   /*** Delete the factory. ***/
   if (factory != NULL) {
+    if (metricsWriter.IsOpen())
+      metricsWriter.Write(factory->GetMetrics());
+    metricsWriter.Close();
     delete factory;
     factory = NULL;
   }
@@ -192,6 +645,12 @@ static void close() {
     factorySpritesheet = NULL;
   }
 
+  /*** Destroy the backbuffer. ***/
+  if (backbuffer != NULL) {
+    SDL_DestroyTexture(backbuffer);
+    backbuffer = NULL;
+  }
+
   /*** Destroy the renderer. ***/
   if (sdlRenderer != NULL) {
     SDL_DestroyRenderer(sdlRenderer);
@@ -204,19 +663,278 @@ static void close() {
     sdlWindow = NULL;
   }
 
+  /*** Finish writing the checkpoint. ***/
+  checkpointWriter.Close();
+
+  /*** Finish writing the replay. ***/
+  replayLog.Close();
+
+  /*** Finish writing the trace. ***/
+  Trace::Stop();
+
   /*** Quit SDL subsystems. ***/
-  IMG_Quit();
+  if (isImageInitialized) {
+    IMG_Quit();
+    isImageInitialized = false;
+  }
   SDL_Quit();
 }
 
-static void update(unsigned int dt) { factory->Update(dt); }
+/**
+ * `update`
+ *
+ *   Updates the factory by the elapsed ticks of a frame, in fixed steps if
+ *   requested, or by the next recorded step when replaying.
+ */
+static void update(unsigned int dt) {
+  if (replayLog.IsReplaying()) {
+    if (replayLog.Next(dt))
+      step(dt);
+    return;
+  }
+  if (fixedStep == 0) {
+    step(dt);
+    return;
+  }
+  stepRemainder += dt;
+  for (int n = 0; n < MAX_FIXED_STEPS && stepRemainder >= fixedStep; n++) {
+    stepRemainder -= fixedStep;
+    step(fixedStep);
+  }
+  stepRemainder = stepRemainder < fixedStep ? stepRemainder : 0;
+}
+
+/**
+ * `step`
+ *
+ *   Updates the factory once, recording the step and writing checkpoints.
+ */
+static void step(unsigned int dt) {
+  if (replayLog.IsRecording())
+    replayLog.Write(dt);
+  factory->Update(dt);
+  checkpointTicks += dt;
+  if (checkpointPath != NULL && checkpointTicks >= CHECKPOINT_INTERVAL) {
+    snapshot.Clear();
+    factory->Save(snapshot);
+    if (!checkpointWriter.Write(snapshot, checkpointPath))
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Skipped a checkpoint while the last one is written\n");
+    checkpointTicks = 0;
+  }
+}
 
 static void draw() {
+  if (backbuffer != NULL) {
+    drawPartial();
+    return;
+  }
   SDL_RenderClear(sdlRenderer);
   factory->Draw(sdlRenderer);
+  if (showProfile)
+    Profiler::DrawOverlay(sdlRenderer, 8, 8);
   SDL_RenderPresent(sdlRenderer);
 }
 
+/**
+ * `drawPartial`
+ *
+ *   Redraws the changed regions of the factory into the backbuffer and
+ *   presents it. Nothing is drawn or presented while the factory is unchanged.
+ */
+static void drawPartial() {
+  SDL_Rect viewport;
+  viewport.x = 0;
+  viewport.y = 0;
+  viewport.w = SCREEN_WIDTH;
+  viewport.h = SCREEN_HEIGHT;
+  factory->FindDirtyRegions(viewport, dirtyRegions);
+  if (dirtyRegions.empty() && !showProfile && !isPresentNeeded)
+    return;
+  SDL_SetRenderTarget(sdlRenderer, backbuffer);
+  for (const SDL_Rect &region : dirtyRegions) {
+    SDL_RenderSetClipRect(sdlRenderer, &region);
+    SDL_RenderFillRect(sdlRenderer, &region);
+    factory->Draw(sdlRenderer, region);
+  }
+  SDL_RenderSetClipRect(sdlRenderer, NULL);
+  SDL_SetRenderTarget(sdlRenderer, NULL);
+  SDL_RenderCopy(sdlRenderer, backbuffer, NULL, NULL);
+  if (showProfile)
+    Profiler::DrawOverlay(sdlRenderer, 8, 8);
+  SDL_RenderPresent(sdlRenderer);
+  isPresentNeeded = false;
+}
+
+/**
+ * `drawState`
+ *
+ *   Draws the newest render state published by the simulation thread. Nothing
+ *   is drawn or presented until a new state is published.
+ */
+static void drawState() {
+  if (!renderBuffer.Acquire() && !showProfile && !isPresentNeeded)
+    return;
+  SDL_RenderClear(sdlRenderer);
+  renderBuffer.GetFront().Draw(sdlRenderer);
+  if (showProfile)
+    Profiler::DrawOverlay(sdlRenderer, 8, 8);
+  SDL_RenderPresent(sdlRenderer);
+  isPresentNeeded = false;
+}
+
+/**
+ * `simulate`
+ *
+ *   Updates the factory and publishes its render state at the target frame
+ *   rate until the main thread stops it. Presenting never holds up an update,
+ *   and a slow update only delays the next published state.
+ */
+static void simulate() {
+  FramePacer pacer;
+  pacer.SetTargetRate(targetFps);
+  SDL_Rect viewport;
+  viewport.x = 0;
+  viewport.y = 0;
+  viewport.w = SCREEN_WIDTH;
+  viewport.h = SCREEN_HEIGHT;
+  unsigned int currTick = SDL_GetTicks();
+  unsigned int prevTick = currTick;
+  unsigned int profileTick = currTick;
+  unsigned long long metricsTicks = 0;
+  while (!isSimulationStopping) {
+    update(currTick - prevTick);
+    factory->Capture(renderBuffer.GetBack(), viewport);
+    renderBuffer.Publish();
+    Profiler::EndFrame();
+    metricsTicks += currTick - prevTick;
+    if (metricsWriter.IsOpen() && metricsTicks >= METRICS_INTERVAL) {
+      metricsWriter.Write(factory->GetMetrics());
+      metricsTicks = 0;
+    }
+    if (Profiler::IsEnabled() &&
+        currTick - profileTick >= PROFILE_LOG_INTERVAL) {
+      Profiler::LogSummary();
+      profileTick = currTick;
+    }
+    pacer.Wait();
+    prevTick = currTick;
+    currTick = SDL_GetTicks();
+  }
+}
+
+/**
+ * `loadLayout`
+ *
+ *   Loads the layout from file or generates it.
+ */
+static bool loadLayout(FactoryLayout &layout) {
+  if (!isGenerated)
+    return layout.Load(layoutPath);
+  scenarioGenerator.Generate(layout);
+  return true;
+}
+
+/**
+ * `restoreFactory`
+ *
+ *   Restores the factory from a snapshot file, if one is given, and skips the
+ *   replay to the same point.
+ */
+static bool restoreFactory(const char *path) {
+  if (path == NULL)
+    return true;
+  if (!snapshot.Load(path) || !factory->Restore(snapshot))
+    return false;
+  if (replayLog.IsReplaying() && !replayLog.SkipTo(factory->GetElapsed()))
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "The snapshot was not taken between recorded updates\n");
+  return true;
+}
+
+/**
+ * `runHeadless`
+ *
+ *   Runs the simulation for the given number of ticks without a window and
+ *   logs how long it took.
+ */
+static int runHeadless(unsigned long long ticks, const char *restorePath) {
+
+  /*** Build the factory. ***/
+  Uint64 frequency = SDL_GetPerformanceFrequency();
+  Uint64 start = SDL_GetPerformanceCounter();
+  FactoryLayout layout;
+  if (!loadLayout(layout))
+    return -1;
+  factory = new Factory(NULL, 0, 0, layout.width, layout.height);
+  factory->SetCandidateCount(candidateCount);
+  factory->SetBatchedAssignment(isBatchedAssignment);
+  factory->SetThreadCount(threadCount);
+  factory->SetDeferredEvents(isDeferringEvents);
+  factory->SetAnytimeBudget(anytimeBudget);
+  factory->SetPipelinedPlanning(isPipelinedPlanning);
+  factory->Load(layout);
+  if (!restoreFactory(restorePath)) {
+    close();
+    return -1;
+  }
+  Uint64 loaded = SDL_GetPerformanceCounter();
+
+  /*** Update at a fixed step, or as recorded when replaying. ***/
+  unsigned int frameStep = fixedStep > 0 ? fixedStep : HEADLESS_STEP;
+  unsigned long long startTicks = factory->GetElapsed();
+  unsigned long long metricsTicks = startTicks;
+  unsigned long long steps = 0;
+  while (factory->GetElapsed() - startTicks < ticks &&
+         !(replayLog.IsReplaying() && replayLog.IsAtEnd())) {
+    update(frameStep);
+    Profiler::EndFrame();
+    steps++;
+    if (metricsWriter.IsOpen() &&
+        factory->GetElapsed() - metricsTicks >= METRICS_INTERVAL) {
+      metricsWriter.Write(factory->GetMetrics());
+      metricsTicks = factory->GetElapsed();
+    }
+  }
+  Uint64 end = SDL_GetPerformanceCounter();
+
+  /*** Log the results. ***/
+  FactoryMetrics metrics = factory->GetMetrics();
+  SDL_Log("%dx%d, %u consumers, %u producers, %u robots: load %.1f ms, "
+          "update %.1f ms (%.3f ms per step), %.0f deliveries per hour\n",
+          layout.width, layout.height,
+          static_cast<unsigned>(layout.consumers.size()),
+          static_cast<unsigned>(layout.producers.size()),
+          static_cast<unsigned>(layout.robots.size()),
+          1000.0 * (loaded - start) / frequency,
+          1000.0 * (end - loaded) / frequency,
+          1000.0 * (end - loaded) / frequency / (steps > 0 ? steps : 1),
+          metrics.GetDeliveriesPerHour());
+  if (Profiler::IsEnabled())
+    Profiler::LogSummary();
+
+  close();
+  return 0;
+}
+
+/**
+ * `initImage`
+ *
+ *   Initializes PNG loading. Baked textures load without it.
+ */
+static bool initImage() {
+  if (isImageInitialized)
+    return true;
+  const int imgFlags = IMG_INIT_PNG;
+  if (!(IMG_Init(imgFlags) & imgFlags)) {
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Unable to initialize SDL_Image: %s\n",
+                 IMG_GetError());
+    return false;
+  }
+  isImageInitialized = true;
+  return true;
+}
+
 /**
  * `loadTexture`
  *
@@ -224,6 +942,10 @@ static void draw() {
  */
 static SDL_Texture *loadTexture(const char *const file) {
 
+  /*** Initialize PNG loading. ***/
+  if (!initImage())
+    return NULL;
+
   /*** Load the image as a surface. ***/
   SDL_Surface *surface = IMG_Load(file);
   if (surface == NULL) {
@@ -0,0 +1,186 @@
+/*******************************************************************************
+@file `FactoryTest.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "Factory.h"
+#include "RenderState.h"
+#include "ScenarioGenerator.h"
+#include "Snapshot.h"
+#include "Test.h"
+
+/**
+ * `FACTORY_TEST_TICKS`
+ *
+ *   The number of ticks each factory is simulated for.
+ */
+#define FACTORY_TEST_TICKS 60000
+
+/**
+ * `FACTORY_TEST_SCENARIO`
+ *
+ *   The generated layout each factory is simulated on.
+ */
+#define FACTORY_TEST_SCENARIO                                                  \
+  "width=48,height=48,robots=40,producers=20,consumers=20,obstacles=0.2,seed=3"
+
+/**
+ * `simulate`
+ *
+ *   Simulates a factory on the given number of threads and takes a snapshot
+ *   of it at the end.
+ */
+static void simulate(const FactoryLayout &layout, unsigned int threadCount,
+                     bool isPipelined, Snapshot &snapshot) {
+  Factory factory(NULL, 0, 0, layout.width, layout.height);
+  factory.SetThreadCount(threadCount);
+  factory.SetPipelinedPlanning(isPipelined);
+  factory.SetAnytimeBudget(isPipelined ? 7 : 0);
+  factory.Load(layout);
+  for (unsigned int t = 0; t < FACTORY_TEST_TICKS; t += 16)
+    factory.Update(16);
+  factory.Save(snapshot);
+}
+
+/**
+ * `isSame`
+ *
+ *   Compares two snapshots byte by byte.
+ */
+static bool isSame(Snapshot &a, Snapshot &b) {
+  if (a.GetSize() != b.GetSize())
+    return false;
+  a.Rewind();
+  b.Rewind();
+  for (std::size_t i = 0; i < a.GetSize(); ++i) {
+    char x, y;
+    a.Read(x);
+    b.Read(y);
+    if (x != y)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * `CheckThreadCountIndependence`
+ *
+ *   Checks that a factory simulated on one thread ends in the same state as
+ *   on several.
+ */
+static void CheckThreadCountIndependence(bool isPipelined) {
+  ScenarioGenerator generator;
+  CHECK(generator.Parse(FACTORY_TEST_SCENARIO));
+  FactoryLayout layout;
+  generator.Generate(layout);
+  Snapshot single, multiple;
+  simulate(layout, 1, isPipelined, single);
+  simulate(layout, 4, isPipelined, multiple);
+  CHECK(single.GetSize() > 0);
+  CHECK(isSame(single, multiple));
+}
+
+TEST(ThreadCountDoesNotChangeResult) { CheckThreadCountIndependence(false); }
+
+TEST(ThreadCountDoesNotChangePipelinedResult) {
+  CheckThreadCountIndependence(true);
+}
+
+TEST(RestoredFactoryDrawsTheSameFrames) {
+  ScenarioGenerator generator;
+  CHECK(generator.Parse(FACTORY_TEST_SCENARIO));
+  FactoryLayout layout;
+  generator.Generate(layout);
+  Factory original(NULL, 0, 0, layout.width, layout.height);
+  original.Load(layout);
+  for (unsigned int t = 0; t < FACTORY_TEST_TICKS; t += 16)
+    original.Update(16);
+  Snapshot snapshot;
+  original.Save(snapshot);
+  Factory restored(NULL, 0, 0, layout.width, layout.height);
+  restored.Load(layout);
+  snapshot.Rewind();
+  CHECK(restored.Restore(snapshot));
+
+  // Some frames only change after a while, so look a little ahead too.
+  SDL_Rect region = {0, 0, original.GetDrawWidth(), original.GetDrawHeight()};
+  RenderState a, b;
+  for (int step = 0; step < 8; ++step) {
+    original.Capture(a, region);
+    restored.Capture(b, region);
+    CHECK(a.GetSprites().size() == b.GetSprites().size());
+    for (std::size_t i = 0; i < a.GetSprites().size() &&
+                            i < b.GetSprites().size();
+         ++i) {
+      const SDL_Rect &x = a.GetSprites()[i].spriteRegion;
+      const SDL_Rect &y = b.GetSprites()[i].spriteRegion;
+      CHECK(x.x == y.x && x.y == y.y);
+    }
+    original.Update(100);
+    restored.Update(100);
+  }
+}
+
+TEST(NearestCandidatesSkipUnreachableStations) {
+  // Eight stations walled in next to the origin, and eight reachable ones
+  // across the map.
+  FactoryLayout layout;
+  layout.width = 32;
+  layout.height = 16;
+  layout.blocked.assign(layout.width * layout.height, 0);
+  for (int i = 2; i <= 8; ++i) {
+    layout.blocked[2 * layout.width + i] = 1;
+    layout.blocked[8 * layout.width + i] = 1;
+    layout.blocked[i * layout.width + 2] = 1;
+    layout.blocked[i * layout.width + 8] = 1;
+  }
+  FactoryLayout::Station station;
+  station.busyDelay = 1000;
+  for (int i = 0; i < 8; ++i) {
+    station.point.x = 4 + i % 3;
+    station.point.y = 4 + i / 3;
+    layout.producers.push_back(station);
+    station.point.x = 24 + i % 4;
+    station.point.y = 6 + i / 4;
+    layout.producers.push_back(station);
+  }
+  Factory factory(NULL, 0, 0, layout.width, layout.height);
+  factory.Load(layout);
+
+  SDL_Point origin = {10, 5};
+  std::vector<Machine *> nearest;
+  factory.FindNearestCandidates(origin, true, 8, nearest);
+  CHECK(nearest.size() == 8);
+  for (Machine *m : nearest)
+    CHECK(m->GetFactoryPoint().x >= 24);
+}
+
+TEST(UnreachableCandidatesDoNotKeepRobotsAwake) {
+  // A producer walled in, and a robot outside with nothing else to do.
+  FactoryLayout layout;
+  layout.width = 16;
+  layout.height = 16;
+  layout.blocked.assign(layout.width * layout.height, 0);
+  for (int i = 2; i <= 8; ++i) {
+    layout.blocked[2 * layout.width + i] = 1;
+    layout.blocked[8 * layout.width + i] = 1;
+    layout.blocked[i * layout.width + 2] = 1;
+    layout.blocked[i * layout.width + 8] = 1;
+  }
+  FactoryLayout::Station station;
+  station.busyDelay = 1000;
+  station.point.x = 5;
+  station.point.y = 5;
+  layout.producers.push_back(station);
+  SDL_Point robot = {12, 12};
+  layout.robots.push_back(robot);
+  Factory factory(NULL, 0, 0, layout.width, layout.height);
+  factory.Load(layout);
+
+  for (int i = 0; i < 10; ++i)
+    factory.Update(16);
+  CHECK(factory.GetIdleTicks() > 0);
+}
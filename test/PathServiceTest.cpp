@@ -0,0 +1,83 @@
+/*******************************************************************************
+@file `PathServiceTest.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "PathService.h"
+#include "Test.h"
+#include "TestMap.h"
+#include <climits>
+#include <stdlib.h>
+
+/**
+ * `PATH_SERVICE_TEST_ROUNDS`
+ *
+ *   The number of batches of queries solved.
+ */
+#define PATH_SERVICE_TEST_ROUNDS 10
+
+/**
+ * `PATH_SERVICE_TEST_STARTS`
+ *
+ *   The number of starts in each batch, each queried to every station.
+ */
+#define PATH_SERVICE_TEST_STARTS 20
+
+TEST(ServicePathsMatchPerPairSearches) {
+  TestMap map(48, 48, 20, 20, 5);
+  PathService service(map.walkableGrid);
+  const std::size_t stationCount = map.stations.size();
+
+  for (int round = 0; round < PATH_SERVICE_TEST_ROUNDS; ++round) {
+    std::vector<SDL_Point> starts;
+    for (int i = 0; i < PATH_SERVICE_TEST_STARTS; ++i)
+      starts.push_back(map.RandomWalkablePoint());
+    // A shared start, and a start on a station, are legitimate queries too.
+    starts.push_back(starts.front());
+    starts.push_back(map.stations.front()->GetFactoryPoint());
+
+    std::vector<PathService::TargetPath> answers(starts.size() * stationCount);
+    std::vector<unsigned int> costs(answers.size());
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+      for (std::size_t j = 0; j < stationCount; ++j) {
+        PathService::TargetPath *answer = &answers[i * stationCount + j];
+        service.Request(starts[i], map.stations[j],
+                        [answer](PathService::TargetPath &result) {
+                          *answer = result;
+                        });
+        unsigned int *cost = &costs[i * stationCount + j];
+        service.RequestCost(starts[i], map.stations[j],
+                            [cost](unsigned int result) { *cost = result; });
+      }
+    }
+    service.Solve();
+
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+      for (std::size_t j = 0; j < stationCount; ++j) {
+        const PathService::TargetPath &answer = answers[i * stationCount + j];
+        SDL_Point goal = map.stations[j]->GetFactoryPoint();
+        CHECK(answer.first == map.stations[j]);
+        const std::vector<SDL_Point> &path = answer.second;
+        CHECK(path.size() == map.SearchPath(starts[i], goal).size());
+        if (path.empty()) {
+          CHECK(costs[i * stationCount + j] == UINT_MAX);
+          continue;
+        }
+        CHECK(path.front().x == goal.x && path.front().y == goal.y);
+        CHECK(path.back().x == starts[i].x && path.back().y == starts[i].y);
+        unsigned int cost = 0;
+        for (std::size_t k = 1; k < path.size(); ++k) {
+          CHECK(abs(path[k].x - path[k - 1].x) <= 1 &&
+                abs(path[k].y - path[k - 1].y) <= 1);
+          CHECK(map.walkableGrid.IsWalkable(path[k]));
+          cost += EightWayNeighborhood::Cost(path[k].x - path[k - 1].x,
+                                             path[k].y - path[k - 1].y);
+        }
+        CHECK(costs[i * stationCount + j] == cost);
+      }
+    }
+  }
+}
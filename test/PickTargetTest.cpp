@@ -0,0 +1,91 @@
+/*******************************************************************************
+@file `PickTargetTest.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "PickTargetAlgorithm.h"
+#include "Test.h"
+#include "TestMap.h"
+
+/**
+ * `PICK_TEST_TRIALS`
+ *
+ *   The number of origins a target is picked from.
+ */
+#define PICK_TEST_TRIALS 200
+
+/**
+ * `CheckPickedTargets`
+ *
+ *   Picks targets from random origins and checks that each path is as short
+ *   as the shortest one found by searching every candidate. If `removeAfter`
+ *   is nonzero, the nearest candidate is removed after that many iterations.
+ */
+static void CheckPickedTargets(unsigned int removeAfter) {
+  TestMap map(48, 48, 20, 20, 3);
+  std::pair<StructureMachine *, std::vector<SDL_Point>> picked;
+  bool isDone = false;
+  PickTargetAlgorithm pick(
+      [&](std::pair<StructureMachine *, std::vector<SDL_Point>> &result) {
+        picked = result;
+        isDone = true;
+      },
+      [](std::vector<SDL_Point> &) {}, map.walkableGrid);
+
+  for (int trial = 0; trial < PICK_TEST_TRIALS; ++trial) {
+    SDL_Point origin = map.RandomWalkablePoint();
+    std::list<StructureMachine *> candidates = map.GetCandidates();
+
+    // The exhaustive search, which also tells which candidate to remove.
+    StructureMachine *nearest = NULL;
+    std::size_t shortest = 0;
+    std::size_t secondShortest = 0;
+    for (StructureMachine *candidate : candidates) {
+      std::size_t length =
+          map.SearchPath(origin, candidate->GetFactoryPoint()).size();
+      if (length == 0)
+        continue;
+      if (nearest == NULL || length < shortest) {
+        secondShortest = nearest == NULL ? 0 : shortest;
+        nearest = candidate;
+        shortest = length;
+      } else if (secondShortest == 0 || length < secondShortest) {
+        secondShortest = length;
+      }
+    }
+
+    StructureMachine *removed = NULL;
+    picked.first = NULL;
+    picked.second.clear();
+    isDone = !pick.Begin(origin, candidates);
+    for (unsigned int i = 1; !isDone; ++i) {
+      pick.Next();
+      if (i == removeAfter && !isDone && nearest != NULL) {
+        pick.RemoveCandidate(nearest);
+        removed = nearest;
+        shortest = secondShortest;
+      }
+    }
+
+    CHECK(picked.second.size() == shortest);
+    CHECK(removed == NULL || picked.first != removed);
+    if (picked.second.empty())
+      continue;
+    SDL_Point goal = picked.first->GetFactoryPoint();
+    CHECK(picked.second.front().x == goal.x &&
+          picked.second.front().y == goal.y);
+    CHECK(picked.second.back().x == origin.x &&
+          picked.second.back().y == origin.y);
+  }
+}
+
+TEST(PickedTargetsAreNearest) { CheckPickedTargets(0); }
+
+TEST(PickedTargetsAreNearestAfterRemoval) {
+  CheckPickedTargets(10);
+  CheckPickedTargets(40);
+  CheckPickedTargets(200);
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+@file `RenderBufferTest.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "RenderBuffer.h"
+#include "Test.h"
+#include <thread>
+
+/**
+ * `RENDER_BUFFER_TEST_STATES`
+ *
+ *   The number of states published.
+ */
+#define RENDER_BUFFER_TEST_STATES 20000
+
+/**
+ * `RENDER_BUFFER_TEST_TILES`
+ *
+ *   The number of tiles in each state.
+ */
+#define RENDER_BUFFER_TEST_TILES 64
+
+TEST(AcquiredStatesAreWholeAndNewer) {
+  RenderBuffer buffer;
+  CHECK(!buffer.Acquire());
+  CHECK(buffer.GetFront().GetBlocked().empty());
+
+  // Each state is stamped with its number in every tile, so a state being
+  // overwritten while it is read shows up as mixed or missing stamps.
+  std::thread simulation([&buffer]() {
+    for (int n = 1; n <= RENDER_BUFFER_TEST_STATES; ++n) {
+      RenderState &state = buffer.GetBack();
+      state.Clear();
+      for (int i = 0; i < RENDER_BUFFER_TEST_TILES; ++i) {
+        SDL_Rect tile = {n, i, 1, 1};
+        state.AddBlocked(tile);
+      }
+      buffer.Publish();
+    }
+  });
+
+  int last = 0;
+  int acquired = 0;
+  int torn = 0;
+  while (last < RENDER_BUFFER_TEST_STATES) {
+    if (!buffer.Acquire())
+      continue;
+    ++acquired;
+    const std::vector<SDL_Rect> &tiles = buffer.GetFront().GetBlocked();
+    int n = tiles.empty() ? 0 : tiles.front().x;
+    bool isWhole = tiles.size() == RENDER_BUFFER_TEST_TILES;
+    for (std::size_t i = 0; i < tiles.size(); ++i)
+      isWhole = isWhole && tiles[i].x == n && tiles[i].y == static_cast<int>(i);
+    torn += !isWhole;
+    CHECK(n > last);
+    last = n;
+  }
+  simulation.join();
+
+  CHECK(torn == 0);
+  CHECK(acquired > 0);
+  // Everything published was acquired, so nothing is fresh.
+  CHECK(!buffer.Acquire());
+}
@@ -0,0 +1,128 @@
+/*******************************************************************************
+@file `SearchPathTest.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "SearchPathAlgorithm.h"
+#include "Test.h"
+#include <functional>
+#include <queue>
+#include <random>
+#include <stdlib.h>
+
+/**
+ * `SEARCH_TEST_TRIALS`
+ *
+ *   The number of random grids searched for each neighborhood and heuristic.
+ */
+#define SEARCH_TEST_TRIALS 300
+
+/**
+ * `Dijkstra`
+ *
+ *   Calculates the cost of the shortest path between two points by expanding
+ *   every point in order of its cost from the start.
+ *
+ * @returns
+ *   The cost of the shortest path, or the largest unsigned integer if the goal
+ *   is unreachable.
+ */
+template <class Neighborhood>
+static unsigned int Dijkstra(const WalkableGrid &grid, SDL_Point start,
+                             SDL_Point goal) {
+  typedef std::pair<unsigned int, int> Entry;
+  const SDL_Point size = grid.GetSize();
+  std::vector<unsigned int> costs(size.x * size.y, ~0u);
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  costs[start.y * size.x + start.x] = 0;
+  open.push(Entry(0, start.y * size.x + start.x));
+  while (!open.empty()) {
+    Entry entry = open.top();
+    open.pop();
+    if (entry.first > costs[entry.second])
+      continue;
+    for (int i = 0; i < Neighborhood::Count; ++i) {
+      const int dx = Neighborhood::Offsets[i][0];
+      const int dy = Neighborhood::Offsets[i][1];
+      SDL_Point next = {entry.second % size.x + dx, entry.second / size.x + dy};
+      if (!grid.IsWalkable(next))
+        continue;
+      unsigned int cost = entry.first + Neighborhood::Cost(dx, dy);
+      unsigned int &best = costs[next.y * size.x + next.x];
+      if (cost < best) {
+        best = cost;
+        open.push(Entry(cost, next.y * size.x + next.x));
+      }
+    }
+  }
+  return costs[goal.y * size.x + goal.x];
+}
+
+/**
+ * `CheckShortestPaths`
+ *
+ *   Searches random grids and checks that every path found is a shortest one
+ *   from the start to the goal, and that no path is found to an unreachable
+ *   goal.
+ */
+template <class Neighborhood, class Heuristic>
+static void CheckShortestPaths(int width, int height, int obstaclePercent) {
+  std::mt19937 random(5);
+  for (int trial = 0; trial < SEARCH_TEST_TRIALS; ++trial) {
+    std::vector<char> blocked(width * height);
+    for (char &tile : blocked)
+      tile = static_cast<int>(random() % 100) < obstaclePercent;
+    SDL_Point start = {static_cast<int>(random() % width),
+                       static_cast<int>(random() % height)};
+    SDL_Point goal = {static_cast<int>(random() % width),
+                      static_cast<int>(random() % height)};
+    blocked[start.y * width + start.x] = 0;
+    blocked[goal.y * width + goal.x] = 0;
+    SDL_Point size = {width, height};
+    WalkableGrid grid(size, blocked);
+
+    std::vector<SDL_Point> path;
+    BasicSearchPathAlgorithm<Neighborhood, Heuristic> search(
+        [&path](std::vector<SDL_Point> &result) { path = result; }, grid);
+    if (search.Begin(start, goal))
+      while (search.Next())
+        ;
+
+    unsigned int best = Dijkstra<Neighborhood>(grid, start, goal);
+    if (best == ~0u) {
+      CHECK(path.empty());
+      continue;
+    }
+    CHECK(!path.empty());
+    if (path.empty())
+      continue;
+    CHECK(path.front().x == goal.x && path.front().y == goal.y);
+    CHECK(path.back().x == start.x && path.back().y == start.y);
+    unsigned int cost = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+      const int dx = path[i].x - path[i - 1].x;
+      const int dy = path[i].y - path[i - 1].y;
+      CHECK(abs(dx) <= 1 && abs(dy) <= 1 && (dx != 0 || dy != 0));
+      CHECK(Neighborhood::Count == 8 || dx == 0 || dy == 0);
+      CHECK(grid.IsWalkable(path[i]));
+      cost += Neighborhood::Cost(dx, dy);
+    }
+    CHECK(cost == best);
+  }
+}
+
+TEST(FourWayManhattanPathsAreShortest) {
+  CheckShortestPaths<FourWayNeighborhood, ManhattanHeuristic>(40, 30, 30);
+}
+
+TEST(EightWayOctilePathsAreShortest) {
+  CheckShortestPaths<EightWayNeighborhood, OctileHeuristic>(40, 30, 30);
+  CheckShortestPaths<EightWayNeighborhood, OctileHeuristic>(200, 20, 35);
+}
+
+TEST(EightWayChebyshevPathsAreShortest) {
+  CheckShortestPaths<EightWayNeighborhood, ChebyshevHeuristic>(40, 30, 30);
+}
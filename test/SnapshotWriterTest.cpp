@@ -0,0 +1,52 @@
+/*******************************************************************************
+@file `SnapshotWriterTest.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "SnapshotWriter.h"
+#include "Test.h"
+#include <cstdio>
+
+/**
+ * `SNAPSHOT_WRITER_TEST_PATH`
+ *
+ *   The file the snapshots are written to, removed at the end.
+ */
+#define SNAPSHOT_WRITER_TEST_PATH "snapshot_writer_test.bin"
+
+/**
+ * `SNAPSHOT_WRITER_TEST_WRITES`
+ *
+ *   The number of snapshots handed over back to back.
+ */
+#define SNAPSHOT_WRITER_TEST_WRITES 200
+
+TEST(WrittenSnapshotIsTheLastHandedOver) {
+  SnapshotWriter writer;
+  Snapshot snapshot;
+  int last = -1;
+  for (int n = 0; n < SNAPSHOT_WRITER_TEST_WRITES; ++n) {
+    snapshot.Clear();
+    for (int i = 0; i < 1000; ++i)
+      snapshot.Write(n);
+    if (writer.Write(snapshot, SNAPSHOT_WRITER_TEST_PATH))
+      last = n;
+  }
+  writer.Close();
+  CHECK(last >= 0);
+
+  // Snapshots refused while the previous one was written are not written.
+  Snapshot loaded;
+  CHECK(loaded.Load(SNAPSHOT_WRITER_TEST_PATH));
+  CHECK(loaded.GetSize() == 1000 * sizeof(int));
+  for (int i = 0; i < 1000; ++i) {
+    int value = -1;
+    loaded.Read(value);
+    CHECK(value == last);
+  }
+  CHECK(loaded.IsValid());
+  std::remove(SNAPSHOT_WRITER_TEST_PATH);
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+@file `Test.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include <stdio.h>
+
+/**
+ * `TestCase`
+ *
+ *   A test registered with the test runner.
+ *
+ * @description
+ *   Test cases are defined with `TEST` at namespace scope and link
+ *   themselves into a list when the test binary starts, so adding a test file
+ *   to the `test` directory is enough to have it run.
+ */
+struct TestCase {
+  typedef void (*Function)();
+
+  const char *name;
+  Function function;
+  TestCase *next;
+
+  /**
+   * `TestCase`
+   *
+   *   Constructor. Adds the test case to the end of the list of test cases.
+   */
+  TestCase(const char *name, Function function)
+      : name(name), function(function), next(NULL) {
+    *Last() = this;
+    Last() = &next;
+  }
+
+  /**
+   * `First`
+   *
+   *   Gets the first registered test case.
+   */
+  static TestCase *&First() {
+    static TestCase *first = NULL;
+    return first;
+  }
+
+  /**
+   * `Last`
+   *
+   *   Gets where the next registered test case is to be linked.
+   */
+  static TestCase **&Last() {
+    static TestCase **last = &First();
+    return last;
+  }
+
+  /**
+   * `Failures`
+   *
+   *   Gets the number of checks that failed in the running test case.
+   */
+  static int &Failures() {
+    static int failures = 0;
+    return failures;
+  }
+};
+
+/**
+ * `TEST`
+ *
+ *   Defines and registers a test case with the given name.
+ */
+#define TEST(name)                                                             \
+  static void name();                                                          \
+  static TestCase name##Case(#name, name);                                     \
+  static void name()
+
+/**
+ * `CHECK`
+ *
+ *   Fails the running test case if the condition is false, without stopping
+ *   it.
+ */
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,        \
+              #condition);                                                     \
+      ++TestCase::Failures();                                                  \
+    }                                                                          \
+  } while (0)
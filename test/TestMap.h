@@ -0,0 +1,108 @@
+/*******************************************************************************
+@file `TestMap.h`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#pragma once
+
+#include "ComponentGrid.h"
+#include "ProducerMachine.h"
+#include "SearchPathAlgorithm.h"
+#include <list>
+#include <random>
+#include <vector>
+
+/**
+ * `TestMap`
+ *
+ *   A random map with obstacles and stations, as the factory would hold it,
+ *   for testing path searches against each other.
+ */
+class TestMap {
+public:
+  SDL_Point size;
+  std::vector<char> blocked;
+  ComponentGrid components;
+  WalkableGrid walkableGrid;
+  std::vector<ProducerMachine *> stations;
+  std::mt19937 random;
+
+  /**
+   * `TestMap`
+   *
+   *   Constructor. Blocks the given percentage of tiles at random and places
+   *   the given number of stations on walkable tiles.
+   */
+  TestMap(int width, int height, int obstaclePercent, int stationCount,
+          unsigned int seed)
+      : size(makeSize(width, height)), blocked(width * height),
+        components(size), walkableGrid(size, blocked, &components),
+        random(seed) {
+    for (char &tile : blocked)
+      tile = static_cast<int>(random() % 100) < obstaclePercent;
+    components.Label(blocked);
+    SDL_Rect drawRegion = {0, 0, 32, 32};
+    while (static_cast<int>(stations.size()) < stationCount) {
+      SDL_Point p = RandomWalkablePoint();
+      stations.push_back(new ProducerMachine(NULL, drawRegion, p));
+    }
+  }
+
+  /**
+   * `~TestMap`
+   *
+   *   Destructor.
+   */
+  ~TestMap() {
+    for (ProducerMachine *station : stations)
+      delete station;
+  }
+
+  /**
+   * `RandomWalkablePoint`
+   *
+   *   Gets a random walkable tile.
+   */
+  SDL_Point RandomWalkablePoint() {
+    SDL_Point p;
+    do {
+      p.x = static_cast<int>(random() % size.x);
+      p.y = static_cast<int>(random() % size.y);
+    } while (!walkableGrid.IsWalkable(p));
+    return p;
+  }
+
+  /**
+   * `GetCandidates`
+   *
+   *   Gets the stations as a list of candidates.
+   */
+  std::list<StructureMachine *> GetCandidates() const {
+    return std::list<StructureMachine *>(stations.begin(), stations.end());
+  }
+
+  /**
+   * `SearchPath`
+   *
+   *   Searches the path between two points on its own.
+   */
+  std::vector<SDL_Point> SearchPath(SDL_Point start, SDL_Point goal) const {
+    std::vector<SDL_Point> path;
+    SearchPathAlgorithm search(
+        [&path](std::vector<SDL_Point> &result) { path = result; },
+        walkableGrid);
+    if (search.Begin(start, goal))
+      while (search.Next())
+        ;
+    return path;
+  }
+
+private:
+  static SDL_Point makeSize(int width, int height) {
+    SDL_Point p = {width, height};
+    return p;
+  }
+};
@@ -0,0 +1,42 @@
+/*******************************************************************************
+@file `main.cpp`
+  Created October 19, 2026
+
+@author CJ Dimaano
+  <c.j.s.dimaano@gmail.com>
+*******************************************************************************/
+
+#include "Test.h"
+#include <string.h>
+
+/**
+ * `main`
+ *
+ *   Runs every registered test case, or only those whose names are given on
+ *   the command line, and reports the ones that failed.
+ *
+ * @returns
+ *   Zero if every test case passed; otherwise, one.
+ */
+int main(int argc, char **argv) {
+  int run = 0;
+  int failed = 0;
+  for (TestCase *test = TestCase::First(); test; test = test->next) {
+    bool isSelected = argc < 2;
+    for (int i = 1; i < argc && !isSelected; ++i)
+      isSelected = strcmp(argv[i], test->name) == 0;
+    if (!isSelected)
+      continue;
+    TestCase::Failures() = 0;
+    test->function();
+    ++run;
+    if (TestCase::Failures() != 0) {
+      ++failed;
+      printf("FAIL %s\n", test->name);
+    } else {
+      printf("PASS %s\n", test->name);
+    }
+  }
+  printf("%d of %d tests passed\n", run - failed, run);
+  return failed == 0 ? 0 : 1;
+}